@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/build/Tsan/bin/logme"
+  "/root/repo/build/Tsan/bin/logme.pdb"
+  "CMakeFiles/logme.dir/main.cpp.o"
+  "CMakeFiles/logme.dir/main.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/logme.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,19 @@
+#----------------------------------------------------------------
+# Generated CMake target import file for configuration "Tsan".
+#----------------------------------------------------------------
+
+# Commands may need to know the format version.
+set(CMAKE_IMPORT_FILE_VERSION 1)
+
+# Import target "ert::ert_logger" for configuration "Tsan"
+set_property(TARGET ert::ert_logger APPEND PROPERTY IMPORTED_CONFIGURATIONS TSAN)
+set_target_properties(ert::ert_logger PROPERTIES
+  IMPORTED_LINK_INTERFACE_LANGUAGES_TSAN "CXX"
+  IMPORTED_LOCATION_TSAN "${_IMPORT_PREFIX}/lib/ert/libert_logger.a"
+  )
+
+list(APPEND _cmake_import_check_targets ert::ert_logger )
+list(APPEND _cmake_import_check_files_for_ert::ert_logger "${_IMPORT_PREFIX}/lib/ert/libert_logger.a" )
+
+# Commands beyond this point should not need to know the version.
+set(CMAKE_IMPORT_FILE_VERSION)
@@ -0,0 +1,34 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/BinaryLog.cpp" "src/CMakeFiles/ert_logger.dir/BinaryLog.cpp.o" "gcc" "src/CMakeFiles/ert_logger.dir/BinaryLog.cpp.o.d"
+  "/root/repo/src/Clock.cpp" "src/CMakeFiles/ert_logger.dir/Clock.cpp.o" "gcc" "src/CMakeFiles/ert_logger.dir/Clock.cpp.o.d"
+  "/root/repo/src/Configuration.cpp" "src/CMakeFiles/ert_logger.dir/Configuration.cpp.o" "gcc" "src/CMakeFiles/ert_logger.dir/Configuration.cpp.o.d"
+  "/root/repo/src/ConsoleSink.cpp" "src/CMakeFiles/ert_logger.dir/ConsoleSink.cpp.o" "gcc" "src/CMakeFiles/ert_logger.dir/ConsoleSink.cpp.o.d"
+  "/root/repo/src/DatagramSink.cpp" "src/CMakeFiles/ert_logger.dir/DatagramSink.cpp.o" "gcc" "src/CMakeFiles/ert_logger.dir/DatagramSink.cpp.o.d"
+  "/root/repo/src/FileSink.cpp" "src/CMakeFiles/ert_logger.dir/FileSink.cpp.o" "gcc" "src/CMakeFiles/ert_logger.dir/FileSink.cpp.o.d"
+  "/root/repo/src/FlightRecorder.cpp" "src/CMakeFiles/ert_logger.dir/FlightRecorder.cpp.o" "gcc" "src/CMakeFiles/ert_logger.dir/FlightRecorder.cpp.o.d"
+  "/root/repo/src/Logger.cpp" "src/CMakeFiles/ert_logger.dir/Logger.cpp.o" "gcc" "src/CMakeFiles/ert_logger.dir/Logger.cpp.o.d"
+  "/root/repo/src/MemorySink.cpp" "src/CMakeFiles/ert_logger.dir/MemorySink.cpp.o" "gcc" "src/CMakeFiles/ert_logger.dir/MemorySink.cpp.o.d"
+  "/root/repo/src/RateLimiter.cpp" "src/CMakeFiles/ert_logger.dir/RateLimiter.cpp.o" "gcc" "src/CMakeFiles/ert_logger.dir/RateLimiter.cpp.o.d"
+  "/root/repo/src/RecordQueue.cpp" "src/CMakeFiles/ert_logger.dir/RecordQueue.cpp.o" "gcc" "src/CMakeFiles/ert_logger.dir/RecordQueue.cpp.o.d"
+  "/root/repo/src/SharedRing.cpp" "src/CMakeFiles/ert_logger.dir/SharedRing.cpp.o" "gcc" "src/CMakeFiles/ert_logger.dir/SharedRing.cpp.o.d"
+  "/root/repo/src/SinkWorker.cpp" "src/CMakeFiles/ert_logger.dir/SinkWorker.cpp.o" "gcc" "src/CMakeFiles/ert_logger.dir/SinkWorker.cpp.o.d"
+  "/root/repo/src/Stats.cpp" "src/CMakeFiles/ert_logger.dir/Stats.cpp.o" "gcc" "src/CMakeFiles/ert_logger.dir/Stats.cpp.o.d"
+  "/root/repo/src/SyslogSink.cpp" "src/CMakeFiles/ert_logger.dir/SyslogSink.cpp.o" "gcc" "src/CMakeFiles/ert_logger.dir/SyslogSink.cpp.o.d"
+  "/root/repo/src/Trace.cpp" "src/CMakeFiles/ert_logger.dir/Trace.cpp.o" "gcc" "src/CMakeFiles/ert_logger.dir/Trace.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
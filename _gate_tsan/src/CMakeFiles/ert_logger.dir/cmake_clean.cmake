@@ -0,0 +1,41 @@
+file(REMOVE_RECURSE
+  "/root/repo/build/Tsan/lib/libert_logger.a"
+  "/root/repo/build/Tsan/lib/libert_logger.pdb"
+  "CMakeFiles/ert_logger.dir/BinaryLog.cpp.o"
+  "CMakeFiles/ert_logger.dir/BinaryLog.cpp.o.d"
+  "CMakeFiles/ert_logger.dir/Clock.cpp.o"
+  "CMakeFiles/ert_logger.dir/Clock.cpp.o.d"
+  "CMakeFiles/ert_logger.dir/Configuration.cpp.o"
+  "CMakeFiles/ert_logger.dir/Configuration.cpp.o.d"
+  "CMakeFiles/ert_logger.dir/ConsoleSink.cpp.o"
+  "CMakeFiles/ert_logger.dir/ConsoleSink.cpp.o.d"
+  "CMakeFiles/ert_logger.dir/DatagramSink.cpp.o"
+  "CMakeFiles/ert_logger.dir/DatagramSink.cpp.o.d"
+  "CMakeFiles/ert_logger.dir/FileSink.cpp.o"
+  "CMakeFiles/ert_logger.dir/FileSink.cpp.o.d"
+  "CMakeFiles/ert_logger.dir/FlightRecorder.cpp.o"
+  "CMakeFiles/ert_logger.dir/FlightRecorder.cpp.o.d"
+  "CMakeFiles/ert_logger.dir/Logger.cpp.o"
+  "CMakeFiles/ert_logger.dir/Logger.cpp.o.d"
+  "CMakeFiles/ert_logger.dir/MemorySink.cpp.o"
+  "CMakeFiles/ert_logger.dir/MemorySink.cpp.o.d"
+  "CMakeFiles/ert_logger.dir/RateLimiter.cpp.o"
+  "CMakeFiles/ert_logger.dir/RateLimiter.cpp.o.d"
+  "CMakeFiles/ert_logger.dir/RecordQueue.cpp.o"
+  "CMakeFiles/ert_logger.dir/RecordQueue.cpp.o.d"
+  "CMakeFiles/ert_logger.dir/SharedRing.cpp.o"
+  "CMakeFiles/ert_logger.dir/SharedRing.cpp.o.d"
+  "CMakeFiles/ert_logger.dir/SinkWorker.cpp.o"
+  "CMakeFiles/ert_logger.dir/SinkWorker.cpp.o.d"
+  "CMakeFiles/ert_logger.dir/Stats.cpp.o"
+  "CMakeFiles/ert_logger.dir/Stats.cpp.o.d"
+  "CMakeFiles/ert_logger.dir/SyslogSink.cpp.o"
+  "CMakeFiles/ert_logger.dir/SyslogSink.cpp.o.d"
+  "CMakeFiles/ert_logger.dir/Trace.cpp.o"
+  "CMakeFiles/ert_logger.dir/Trace.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ert_logger.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/build/Tsan/bin/ert_logger_test_binary_clock"
+  "/root/repo/build/Tsan/bin/ert_logger_test_binary_clock.pdb"
+  "CMakeFiles/ert_logger_test_binary_clock.dir/binary_clock.cpp.o"
+  "CMakeFiles/ert_logger_test_binary_clock.dir/binary_clock.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ert_logger_test_binary_clock.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
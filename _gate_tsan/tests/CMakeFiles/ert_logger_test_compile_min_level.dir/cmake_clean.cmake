@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/build/Tsan/bin/ert_logger_test_compile_min_level"
+  "/root/repo/build/Tsan/bin/ert_logger_test_compile_min_level.pdb"
+  "CMakeFiles/ert_logger_test_compile_min_level.dir/compile_min_level.cpp.o"
+  "CMakeFiles/ert_logger_test_compile_min_level.dir/compile_min_level.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ert_logger_test_compile_min_level.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
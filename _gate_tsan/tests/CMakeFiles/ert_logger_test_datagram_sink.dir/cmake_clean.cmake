@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/build/Tsan/bin/ert_logger_test_datagram_sink"
+  "/root/repo/build/Tsan/bin/ert_logger_test_datagram_sink.pdb"
+  "CMakeFiles/ert_logger_test_datagram_sink.dir/datagram_sink.cpp.o"
+  "CMakeFiles/ert_logger_test_datagram_sink.dir/datagram_sink.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ert_logger_test_datagram_sink.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ert_logger_test_format_matched.dir/format_check.cpp.o"
+  "CMakeFiles/ert_logger_test_format_matched.dir/format_check.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ert_logger_test_format_matched.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
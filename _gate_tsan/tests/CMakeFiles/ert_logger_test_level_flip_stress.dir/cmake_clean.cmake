@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/build/Tsan/bin/ert_logger_test_level_flip_stress"
+  "/root/repo/build/Tsan/bin/ert_logger_test_level_flip_stress.pdb"
+  "CMakeFiles/ert_logger_test_level_flip_stress.dir/level_flip_stress.cpp.o"
+  "CMakeFiles/ert_logger_test_level_flip_stress.dir/level_flip_stress.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ert_logger_test_level_flip_stress.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/build/Tsan/bin/ert_logger_test_overflow_policy"
+  "/root/repo/build/Tsan/bin/ert_logger_test_overflow_policy.pdb"
+  "CMakeFiles/ert_logger_test_overflow_policy.dir/overflow_policy.cpp.o"
+  "CMakeFiles/ert_logger_test_overflow_policy.dir/overflow_policy.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ert_logger_test_overflow_policy.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/build/Tsan/bin/ert_logger_test_sink_reconfigure"
+  "/root/repo/build/Tsan/bin/ert_logger_test_sink_reconfigure.pdb"
+  "CMakeFiles/ert_logger_test_sink_reconfigure.dir/sink_reconfigure.cpp.o"
+  "CMakeFiles/ert_logger_test_sink_reconfigure.dir/sink_reconfigure.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ert_logger_test_sink_reconfigure.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
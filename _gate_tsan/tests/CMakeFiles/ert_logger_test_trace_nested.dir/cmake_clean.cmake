@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/build/Tsan/bin/ert_logger_test_trace_nested"
+  "/root/repo/build/Tsan/bin/ert_logger_test_trace_nested.pdb"
+  "CMakeFiles/ert_logger_test_trace_nested.dir/trace_nested.cpp.o"
+  "CMakeFiles/ert_logger_test_trace_nested.dir/trace_nested.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ert_logger_test_trace_nested.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,34 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/BinaryLog.cpp" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/BinaryLog.cpp.o" "gcc" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/BinaryLog.cpp.o.d"
+  "/root/repo/src/Clock.cpp" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/Clock.cpp.o" "gcc" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/Clock.cpp.o.d"
+  "/root/repo/src/Configuration.cpp" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/Configuration.cpp.o" "gcc" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/Configuration.cpp.o.d"
+  "/root/repo/src/ConsoleSink.cpp" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/ConsoleSink.cpp.o" "gcc" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/ConsoleSink.cpp.o.d"
+  "/root/repo/src/DatagramSink.cpp" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/DatagramSink.cpp.o" "gcc" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/DatagramSink.cpp.o.d"
+  "/root/repo/src/FileSink.cpp" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/FileSink.cpp.o" "gcc" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/FileSink.cpp.o.d"
+  "/root/repo/src/FlightRecorder.cpp" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/FlightRecorder.cpp.o" "gcc" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/FlightRecorder.cpp.o.d"
+  "/root/repo/src/Logger.cpp" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/Logger.cpp.o" "gcc" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/Logger.cpp.o.d"
+  "/root/repo/src/MemorySink.cpp" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/MemorySink.cpp.o" "gcc" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/MemorySink.cpp.o.d"
+  "/root/repo/src/RateLimiter.cpp" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/RateLimiter.cpp.o" "gcc" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/RateLimiter.cpp.o.d"
+  "/root/repo/src/RecordQueue.cpp" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/RecordQueue.cpp.o" "gcc" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/RecordQueue.cpp.o.d"
+  "/root/repo/src/SharedRing.cpp" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/SharedRing.cpp.o" "gcc" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/SharedRing.cpp.o.d"
+  "/root/repo/src/SinkWorker.cpp" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/SinkWorker.cpp.o" "gcc" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/SinkWorker.cpp.o.d"
+  "/root/repo/src/Stats.cpp" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/Stats.cpp.o" "gcc" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/Stats.cpp.o.d"
+  "/root/repo/src/SyslogSink.cpp" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/SyslogSink.cpp.o" "gcc" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/SyslogSink.cpp.o.d"
+  "/root/repo/src/Trace.cpp" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/Trace.cpp.o" "gcc" "tests/CMakeFiles/ert_logger_test_warning.dir/__/src/Trace.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
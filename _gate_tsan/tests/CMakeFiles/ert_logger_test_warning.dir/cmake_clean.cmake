@@ -0,0 +1,41 @@
+file(REMOVE_RECURSE
+  "/root/repo/build/Tsan/lib/libert_logger_test_warning.a"
+  "/root/repo/build/Tsan/lib/libert_logger_test_warning.pdb"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/BinaryLog.cpp.o"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/BinaryLog.cpp.o.d"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/Clock.cpp.o"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/Clock.cpp.o.d"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/Configuration.cpp.o"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/Configuration.cpp.o.d"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/ConsoleSink.cpp.o"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/ConsoleSink.cpp.o.d"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/DatagramSink.cpp.o"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/DatagramSink.cpp.o.d"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/FileSink.cpp.o"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/FileSink.cpp.o.d"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/FlightRecorder.cpp.o"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/FlightRecorder.cpp.o.d"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/Logger.cpp.o"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/Logger.cpp.o.d"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/MemorySink.cpp.o"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/MemorySink.cpp.o.d"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/RateLimiter.cpp.o"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/RateLimiter.cpp.o.d"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/RecordQueue.cpp.o"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/RecordQueue.cpp.o.d"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/SharedRing.cpp.o"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/SharedRing.cpp.o.d"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/SinkWorker.cpp.o"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/SinkWorker.cpp.o.d"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/Stats.cpp.o"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/Stats.cpp.o.d"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/SyslogSink.cpp.o"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/SyslogSink.cpp.o.d"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/Trace.cpp.o"
+  "CMakeFiles/ert_logger_test_warning.dir/__/src/Trace.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ert_logger_test_warning.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
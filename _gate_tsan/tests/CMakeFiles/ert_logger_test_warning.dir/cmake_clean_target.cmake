@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "/root/repo/build/Tsan/lib/libert_logger_test_warning.a"
+)
@@ -0,0 +1,34 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tests
+# Build directory: /root/repo/_gate_tsan/tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(compile_min_level "/root/repo/build/Tsan/bin/ert_logger_test_compile_min_level")
+set_tests_properties(compile_min_level PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;13;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(compile_min_level_binary "/usr/bin/cmake" "-DBINARY=/root/repo/build/Tsan/bin/ert_logger_test_compile_min_level" "-P" "/root/repo/tests/compile_min_level.cmake")
+set_tests_properties(compile_min_level_binary PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;14;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(level_flip_stress "/root/repo/build/Tsan/bin/ert_logger_test_level_flip_stress")
+set_tests_properties(level_flip_stress PROPERTIES  ENVIRONMENT "TSAN_OPTIONS=halt_on_error=1" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;20;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(level_flip_stress_async "/root/repo/build/Tsan/bin/ert_logger_test_level_flip_stress" "async")
+set_tests_properties(level_flip_stress_async PROPERTIES  ENVIRONMENT "TSAN_OPTIONS=halt_on_error=1" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;21;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(overflow_policy_DropNewest "/root/repo/build/Tsan/bin/ert_logger_test_overflow_policy" "DropNewest")
+set_tests_properties(overflow_policy_DropNewest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;28;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(overflow_policy_DropOldest "/root/repo/build/Tsan/bin/ert_logger_test_overflow_policy" "DropOldest")
+set_tests_properties(overflow_policy_DropOldest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;28;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(overflow_policy_Block "/root/repo/build/Tsan/bin/ert_logger_test_overflow_policy" "Block")
+set_tests_properties(overflow_policy_Block PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;28;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(overflow_policy_DropBelow "/root/repo/build/Tsan/bin/ert_logger_test_overflow_policy" "DropBelow")
+set_tests_properties(overflow_policy_DropBelow PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;28;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(sink_reconfigure "/root/repo/build/Tsan/bin/ert_logger_test_sink_reconfigure")
+set_tests_properties(sink_reconfigure PROPERTIES  ENVIRONMENT "TSAN_OPTIONS=halt_on_error=1" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;34;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(datagram_sink "/root/repo/build/Tsan/bin/ert_logger_test_datagram_sink")
+set_tests_properties(datagram_sink PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;40;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(binary_clock "/root/repo/build/Tsan/bin/ert_logger_test_binary_clock")
+set_tests_properties(binary_clock PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;45;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(trace_nested "/root/repo/build/Tsan/bin/ert_logger_test_trace_nested")
+set_tests_properties(trace_nested PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;50;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(format_check_matched "/usr/bin/cmake" "--build" "/root/repo/_gate_tsan" "--target" "ert_logger_test_format_matched")
+set_tests_properties(format_check_matched PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;59;add_test;/root/repo/tests/CMakeLists.txt;0;")
+add_test(format_check_mismatch "/usr/bin/cmake" "--build" "/root/repo/_gate_tsan" "--target" "ert_logger_test_format_mismatch")
+set_tests_properties(format_check_mismatch PROPERTIES  WILL_FAIL "TRUE" _BACKTRACE_TRIPLES "/root/repo/tests/CMakeLists.txt;59;add_test;/root/repo/tests/CMakeLists.txt;0;")
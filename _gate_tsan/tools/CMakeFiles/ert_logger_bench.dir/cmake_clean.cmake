@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/build/Tsan/bin/ert_logger_bench"
+  "/root/repo/build/Tsan/bin/ert_logger_bench.pdb"
+  "CMakeFiles/ert_logger_bench.dir/bench.cpp.o"
+  "CMakeFiles/ert_logger_bench.dir/bench.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ert_logger_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
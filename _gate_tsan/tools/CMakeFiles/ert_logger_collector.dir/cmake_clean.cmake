@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/build/Tsan/bin/ert_logger_collector"
+  "/root/repo/build/Tsan/bin/ert_logger_collector.pdb"
+  "CMakeFiles/ert_logger_collector.dir/collector.cpp.o"
+  "CMakeFiles/ert_logger_collector.dir/collector.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ert_logger_collector.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "/root/repo/build/Tsan/bin/ert_logger_decode"
+  "/root/repo/build/Tsan/bin/ert_logger_decode.pdb"
+  "CMakeFiles/ert_logger_decode.dir/decode.cpp.o"
+  "CMakeFiles/ert_logger_decode.dir/decode.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ert_logger_decode.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -13,6 +13,9 @@ function(set_cmake_compiler_flags)
     $<$<CONFIG:Debug>:-O0>
     $<$<CONFIG:Debug>:-g3>
     $<$<CONFIG:Debug>:--coverage>
+    $<$<CONFIG:Tsan>:-O1>
+    $<$<CONFIG:Tsan>:-g>
+    $<$<CONFIG:Tsan>:-fsanitize=thread>
   )
 
   # -Wno-deprecated -Wwrite-strings -Wno-unknown-pragmas -Wno-sign-compare -Wno-maybe-uninitialized -Wno-unused -Wno-reorder
@@ -21,6 +24,9 @@ function(set_cmake_compiler_flags)
 
   link_libraries(
       $<$<CONFIG:Debug>:--coverage>
+    $<$<CONFIG:Tsan>:-O1>
+    $<$<CONFIG:Tsan>:-g>
+    $<$<CONFIG:Tsan>:-fsanitize=thread>
   )
 
 endfunction()
@@ -0,0 +1,5 @@
+# Package configuration of the installed library: imports ert::ert_logger, whose
+# interface carries the include directory, ERT_LOGGER_COMPILE_MIN_LEVEL and threads.
+include(CMakeFindDependencyMacro)
+find_dependency(Threads)
+include("${CMAKE_CURRENT_LIST_DIR}/ert_loggerTargets.cmake")
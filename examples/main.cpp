@@ -63,7 +63,7 @@ void usage(int rc)
 {
     auto& ss = (rc == 0) ? std::cout : std::cerr;
 
-    ss << '\n' << "Usage: " << progname << " <log level> [--verbose (to print traces on console)]" << '\n'
+    ss << '\n' << "Usage: " << progname << " <log level> [--verbose (to print traces on console)] [--async (to write syslog from a background thread)]" << '\n'
        << '\n' << "Log levels allowed: Debug|Informational|Notice|Warning|Error|Critical|Alert|Emergency" << '\n';
 
     _exit(rc);
@@ -72,7 +72,13 @@ void usage(int rc)
 int main(int argc, char* argv[]) {
     progname = basename(argv[0]);
 
-    ert::tracing::Logger::initialize(progname);
+    // Asynchronous mode is selected before initialization:
+    bool async = false;
+    for (int k = 2; k < argc; k++) {
+        if (std::string(argv[k]) == "--async") async = true;
+    }
+    if (async) ert::tracing::Logger::initialize(progname, -1, -1, ert::tracing::AsyncOptions{});
+    else ert::tracing::Logger::initialize(progname);
 
     // Capture TERM/INT signals for graceful exit:
     signal(SIGTERM, sighndl);
@@ -86,8 +92,9 @@ int main(int argc, char* argv[]) {
     {
         usage(EXIT_FAILURE);
     }
-    std::string verbose = (argc > 2) ? argv[2]:"";
-    if (verbose == "--verbose") ert::tracing::Logger::verbose();
+    for (int k = 2; k < argc; k++) {
+        if (std::string(argv[k]) == "--verbose") ert::tracing::Logger::verbose();
+    }
 
 
     std::cout << "Level configured = " << ert::tracing::Logger::getLevel() << '\n';
@@ -109,6 +116,12 @@ int main(int argc, char* argv[]) {
         ert::tracing::Logger::warning(msg, ERT_FILE_LOCATION);
     );
 
+    // Type-safe formatting (no intermediate string):
+    ert::tracing::Logger::warningf(ERT_FILE_LOCATION, "This is WARNING formatted (level {}, {})", ert::tracing::Logger::Warning, "no stack buffer");
+
+    // Call-site macro (prefix rendered at compile time):
+    ERT_LOG_WARNING("This is WARNING from static call site (level {})", ert::tracing::Logger::Warning);
+
     std::string msg;
 
     msg = ert::tracing::Logger::asString("This is ERROR (level %d)", ert::tracing::Logger::Error);
@@ -0,0 +1,255 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <ert/tracing/CallSite.hpp>
+#include <ert/tracing/Clock.hpp>
+
+namespace ert {
+namespace tracing {
+
+/**
+   Deferred binary logging.
+
+   Instead of formatting, a record stores the call-site identifier, a timestamp and
+   the raw argument bytes into a per-thread buffer, which is appended to a binary
+   file when full. Call sites (level, file, line, function and format) are written
+   once to the file, when first used. The 'ert_logger_decode' tool renders the file
+   back into the usual '[Level]|file:line(func)|text' lines.
+
+   Records are stamped with Clock::now() (system_clock when the clock is disabled), so
+   with the TSC a stamp is just a counter read; the calibration converting ticks into
+   wall-clock time is stored in the file when opened and before every records entry.
+
+   File layout: "ERTBLOG2" magic, then entries <kind:u8><size:u32><body>:
+   - 'S' site: <id:u32><level:u8><line:u32><file:str><function:str><format:str>
+   - 'C' calibration: <base ticks:u64><base nanoseconds:i64><nanoseconds per tick:f64>
+   - 'R' records: sequence of <id:u32><stamp:u64><argc:u8><argument>...
+
+   Stamps are nanoseconds since epoch or TSC ticks tagged with the most significant bit
+   (see Clock), converted with the last calibration entry (Clock::toNanoseconds()).
+
+   Strings are <size:u32><bytes> and arguments <tag:u8><value> (see binary::Tag).
+   Integers are stored in host byte order.
+*/
+namespace binary {
+
+constexpr char Magic[] = "ERTBLOG2";
+constexpr std::size_t MagicSize = 8;
+
+enum Kind : std::uint8_t { SiteEntry = 'S', CalibrationEntry = 'C', RecordsEntry = 'R' };
+enum Tag : std::uint8_t { Bool = 1, Char, Int, UInt, Double, String, Pointer };
+
+template <typename T> struct unsupported : std::false_type {};
+
+template <typename T>
+void put(std::vector<char> &out, const T &value) {
+    const char *bytes = reinterpret_cast<const char *>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+inline void putString(std::vector<char> &out, const char *str, std::size_t size) {
+    put(out, (std::uint32_t)size);
+    out.insert(out.end(), str, str + size);
+}
+
+/**
+   Bounded output for encodeArgument, with no allocation: strings are truncated
+   to fit and other values which do not fit set the overflow flag.
+*/
+struct FixedBuffer {
+    char *p;
+    char *end;
+    bool overflow = false;
+
+    void push_back(char c) {
+        if (p < end) *p++ = c;
+        else overflow = true;
+    }
+};
+
+template <typename T>
+void put(FixedBuffer &out, const T &value) {
+    if (out.end - out.p < (std::ptrdiff_t)sizeof(T)) {
+        out.overflow = true;
+        return;
+    }
+    std::memcpy(out.p, &value, sizeof(T));
+    out.p += sizeof(T);
+}
+
+inline void putString(FixedBuffer &out, const char *str, std::size_t size) {
+    std::ptrdiff_t available = out.end - out.p - (std::ptrdiff_t)sizeof(std::uint32_t);
+    if (available < 0) {
+        out.overflow = true;
+        return;
+    }
+    if (size > (std::size_t)available) size = available;
+    put(out, (std::uint32_t)size);
+    std::memcpy(out.p, str, size);
+    out.p += size;
+}
+
+/**
+   Appends a tagged argument (same types as format::appendArgument)
+*/
+template <typename Out, typename T>
+void encodeArgument(Out &out, const T &value) {
+    using D = std::decay_t<T>;
+
+    if constexpr (std::is_same_v<D, bool>) {
+        out.push_back(Bool);
+        out.push_back(value ? 1:0);
+    }
+    else if constexpr (std::is_same_v<D, char>) {
+        out.push_back(Char);
+        out.push_back(value);
+    }
+    else if constexpr (std::is_integral_v<D> && std::is_signed_v<D>) {
+        out.push_back(Int);
+        put(out, (std::int64_t)value);
+    }
+    else if constexpr (std::is_integral_v<D>) {
+        out.push_back(UInt);
+        put(out, (std::uint64_t)value);
+    }
+    else if constexpr (std::is_floating_point_v<D>) {
+        out.push_back(Double);
+        put(out, (double)value);
+    }
+    else if constexpr (std::is_enum_v<D>) {
+        encodeArgument(out, static_cast<std::underlying_type_t<D>>(value));
+    }
+    else if constexpr (std::is_same_v<D, const char*> || std::is_same_v<D, char*>) {
+        const char *str = value;
+        if (!str) str = "(null)";
+        out.push_back(String);
+        putString(out, str, std::strlen(str));
+    }
+    else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        std::string_view view(value);
+        out.push_back(String);
+        putString(out, view.data(), view.size());
+    }
+    else if constexpr (std::is_pointer_v<D> || std::is_null_pointer_v<D>) {
+        out.push_back(Pointer);
+        put(out, (std::uint64_t)(std::uintptr_t)(const void*)value);
+    }
+    else {
+        static_assert(unsupported<T>::value, "ert::tracing::binary: unsupported argument type");
+    }
+}
+
+}
+
+class BinaryLog {
+public:
+    /**
+       Opens (truncates) the binary file. Known call sites are written again.
+
+       @param path Binary file path
+       @param bufferSize Per-thread buffer size flushed to file when exceeded
+
+       @return @em false if the file cannot be opened
+    */
+    static bool open(const std::string &path, std::size_t bufferSize = 65536);
+
+    /**
+       Flushes every thread buffer and closes the file
+    */
+    static void close();
+
+    /**
+       Appends every thread buffer to the file
+    */
+    static void flush();
+
+    /**
+       Records a call-site statement into the calling thread buffer
+
+       @param site Call site
+       @param format Statement format (stored once, on site registration)
+       @param args Format arguments (stored raw)
+    */
+    template <typename... Args>
+    static void write(const CallSite &site, const char *format, const Args &... args) {
+        std::uint32_t id = site.state->id.load(std::memory_order_acquire);
+        if (!id) id = registerSite(site, format);
+
+        ThreadBuffer &buffer = threadBuffer();
+        std::lock_guard<std::mutex> guard(buffer.mutex); // uncontended but for flush()
+
+        std::uint64_t stamp = Clock::now();
+        if (!stamp) stamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        binary::put(buffer.data, id);
+        binary::put(buffer.data, stamp);
+        buffer.data.push_back((char)sizeof...(Args));
+        (binary::encodeArgument(buffer.data, args), ...);
+
+        if (buffer.data.size() >= buffer_size_.load(std::memory_order_relaxed)) flush(buffer);
+    }
+
+private:
+    struct ThreadBuffer {
+        std::mutex mutex;
+        std::vector<char> data;
+
+        ThreadBuffer();
+        ~ThreadBuffer();
+    };
+
+    static std::atomic<std::size_t> buffer_size_;
+    static std::mutex buffers_mutex_;
+    static std::vector<ThreadBuffer*> buffers_;
+
+    static ThreadBuffer &threadBuffer();
+    static std::uint32_t registerSite(const CallSite &site, const char *format);
+    static void flush(ThreadBuffer &buffer); // buffer mutex must be locked
+};
+
+}
+}
+
@@ -0,0 +1,162 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace ert {
+namespace tracing {
+
+/**
+   Mutable state of a log statement, one static instance per call site
+*/
+struct SiteState {
+    std::atomic<std::uint32_t> id{0}; // binary log identifier (0: not registered yet)
+};
+
+/**
+   Static metadata of a log statement, built at compile time by the call-site
+   macros (ERT_LOG, ERT_LOGF, ERT_LOG_DEBUG ... ERT_LOG_EMERGENCY).
+
+   The record prefix '[Level]|file:line(function)|' is rendered once by the
+   compiler, using the file basename instead of the full path, so the hot path
+   only copies the user text after it.
+*/
+struct CallSite {
+    int level; // syslog priority (Logger::Level)
+    const char *file; // basename
+    int line;
+    const char *function;
+    const char *prefix; // '[Level]|file:line(function)|'
+    std::size_t prefixSize;
+    SiteState *state;
+};
+
+namespace callsite {
+
+template <std::size_t N>
+struct Prefix {
+    char data[N + 1];
+};
+
+constexpr std::size_t length(const char *str) {
+    std::size_t result = 0;
+    while (str[result]) result++;
+    return result;
+}
+
+/**
+   @return Path component after the last '/'. Usable at compile time.
+*/
+constexpr const char *basename(const char *path) {
+    const char *result = path;
+    for (const char *p = path; *p; p++) {
+        if (*p == '/') result = p + 1;
+    }
+    return result;
+}
+
+/**
+   @return Level description as Logger::levelAsString(). Usable at compile time.
+*/
+constexpr const char *levelName(int level) {
+    switch (level) {
+    case 0: return "Emergency";
+    case 1: return "Alert";
+    case 2: return "Critical";
+    case 3: return "Error";
+    case 4: return "Warning";
+    case 5: return "Notice";
+    case 6: return "Informational";
+    case 7: return "Debug";
+    }
+    return "<level not supported>";
+}
+
+constexpr std::size_t digits(int value) {
+    std::size_t result = 1;
+    for (; value >= 10; value /= 10) result++;
+    return result;
+}
+
+/**
+   @return Size of the prefix rendered by renderPrefix()
+*/
+constexpr std::size_t prefixSize(int level, const char *file, int line, const char *function) {
+    return length(levelName(level)) + length(basename(file)) + digits(line) + length(function) + 7;
+}
+
+/**
+   Renders '[Level]|file:line(function)|' at compile time
+*/
+template <std::size_t N>
+constexpr Prefix<N> renderPrefix(int level, const char *file, int line, const char *function) {
+    Prefix<N> result{};
+    std::size_t pos = 0;
+    auto put = [&](const char *str) {
+        while (*str) result.data[pos++] = *str++;
+    };
+
+    put("[");
+    put(levelName(level));
+    put("]|");
+    put(basename(file));
+    put(":");
+    const std::size_t lineDigits = digits(line);
+    pos += lineDigits;
+    for (std::size_t k = 1; k <= lineDigits; k++, line /= 10) result.data[pos - k] = '0' + line % 10;
+    put("(");
+    put(function);
+    put(")|");
+    result.data[pos] = '\0';
+    return result;
+}
+
+}
+}
+}
+
+/**
+   Declares a static constexpr CallSite named 'name' for the current source location.
+   Needs to be used inside a function (__func__).
+*/
+#define ERT_CALL_SITE(name, level) \
+    static ert::tracing::SiteState name##_state_; \
+    static constexpr auto name##_prefix_ = ert::tracing::callsite::renderPrefix<ert::tracing::callsite::prefixSize(level, __FILE__, __LINE__, __func__)>(level, __FILE__, __LINE__, __func__); \
+    static constexpr ert::tracing::CallSite name { level, ert::tracing::callsite::basename(__FILE__), __LINE__, __func__, name##_prefix_.data, sizeof(name##_prefix_.data) - 1, &name##_state_ }
+
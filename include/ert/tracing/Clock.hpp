@@ -0,0 +1,174 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define ERT_CLOCK_TSC 1
+#endif
+
+namespace ert {
+namespace tracing {
+
+/**
+   Record timestamp clock.
+
+   Once enabled, records are stamped when logged (Clock::now()) and the raw value
+   travels with them (Record::time), to be converted into wall-clock time only when
+   a sink renders it. With an invariant CPU timestamp counter the stamp is a plain
+   'rdtsc' read, converted with a calibration against system_clock which a background
+   thread refreshes periodically (following NTP adjustments); without it, the clock
+   falls back to system_clock nanoseconds.
+
+   Stamp values: 0 (clock disabled, sinks take the current time), nanoseconds since
+   epoch, or TSC ticks tagged with the most significant bit.
+*/
+class Clock {
+public:
+    /**
+       Enables record timestamping, calibrating the TSC when it is invariant
+       (this takes about 10 milliseconds)
+
+       @param recalibration Background recalibration period
+
+       @return @em true if the TSC is used, @em false on system_clock fallback
+    */
+    static bool enable(std::chrono::milliseconds recalibration = std::chrono::milliseconds(1000));
+
+    /**
+       Disables record timestamping (sinks take the time when writing again)
+    */
+    static void disable();
+
+    /**
+       @return @em true when the TSC is the current source
+    */
+    static bool isTsc() {
+        return (mode_.load(std::memory_order_relaxed) == Tsc);
+    }
+
+    /**
+       @return Current stamp (0 when disabled)
+    */
+    static std::uint64_t now() {
+        switch (mode_.load(std::memory_order_relaxed)) {
+#ifdef ERT_CLOCK_TSC
+        case Tsc: return __rdtsc() | TscTag;
+#endif
+        case System: return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        default: return 0;
+        }
+    }
+
+    /**
+       TSC conversion: nanoseconds since epoch = baseNs + (ticks - baseTicks) * nsPerTick
+    */
+    struct Calibration {
+        std::uint64_t baseTicks = 0;
+        std::int64_t baseNs = 0; // 0: never calibrated
+        double nsPerTick = 0;
+    };
+
+    /**
+       @return Current TSC calibration (async-signal-safe)
+    */
+    static Calibration calibration();
+
+    /**
+       Converts a stamp (async-signal-safe)
+
+       @param stamp Stamp from now() (0: current time)
+
+       @return Nanoseconds since epoch
+    */
+    static std::int64_t toNanoseconds(std::uint64_t stamp);
+
+    /**
+       Converts a stamp with a given calibration, for example one stored along with the
+       stamps to convert them offline
+
+       @param stamp Stamp from now() (0: current time)
+       @param calibration TSC calibration (ignored for other stamps)
+
+       @return Nanoseconds since epoch
+    */
+    static std::int64_t toNanoseconds(std::uint64_t stamp, const Calibration &calibration);
+
+    /**
+       @param stamp Stamp from now() (0: current time)
+
+       @return Wall-clock time
+    */
+    static std::chrono::system_clock::time_point toTime(std::uint64_t stamp) {
+        return std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(toNanoseconds(stamp))));
+    }
+
+private:
+    enum Mode { Disabled, System, Tsc };
+    static constexpr std::uint64_t TscTag = (std::uint64_t)1 << 63;
+
+    static std::atomic<int> mode_;
+
+    // Calibration, published with a seqlock (odd sequence while updating):
+    static std::atomic<std::uint32_t> sequence_;
+    static std::atomic<std::uint64_t> base_ticks_;
+    static std::atomic<std::int64_t> base_ns_;
+    static std::atomic<double> ns_per_tick_;
+
+    // First sample, so the rate is measured over an increasing interval:
+    static std::uint64_t origin_ticks_;
+    static std::int64_t origin_ns_;
+
+    static std::mutex mutex_;
+    static std::condition_variable cv_;
+    static std::thread calibrator_;
+    static bool stopping_;
+
+    static bool isInvariantTsc();
+    static void sample(std::uint64_t &ticks, std::int64_t &ns);
+    static void calibrate(bool initial);
+    static void run(std::chrono::milliseconds period);
+};
+
+}
+}
@@ -0,0 +1,127 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace ert {
+namespace tracing {
+
+/**
+   Logger runtime configuration, applied at once with Logger::configure().
+
+   Every setting absent from a configuration is left unchanged: a configuration only
+   carries the changes to apply. Settings are reverted explicitly: 'default' removes a
+   category level (the application level applies again) and a sampling rate of 1
+   disables sampling for its level.
+
+   Text representation (see parse), one 'key = value' per line, '#' for comments:
+
+   level = Warning
+   verbose = false
+   category.http2 = Debug
+   category.sctp = default
+   sampling.Debug = 0.01
+*/
+struct Configuration {
+    int level = -1; // application level (Logger::Level, -1: unchanged)
+    int verbose = -1; // verbose flag (0, 1 or -1: unchanged)
+    std::map<std::string, int> categories; // category levels set (Logger::Level) or removed (-1); others unchanged
+    double sampling[8] = { -1, -1, -1, -1, -1, -1, -1, -1 }; // keep probability per level (-1: unchanged)
+
+    /**
+       Parses a configuration text
+
+       @param text Configuration text
+       @param error Description of the first error found (output)
+
+       @return @em false on syntax errors (unknown key, level or value)
+    */
+    bool parse(const std::string &text, std::string &error);
+};
+
+/**
+   Background configuration reloader: the configuration file directory is watched
+   with inotify (so replacements by rename, as done by editors or Kubernetes
+   ConfigMap volumes, are seen), and SIGHUP optionally forces a reload. Changed
+   contents are parsed and applied atomically with Logger::configure(); invalid
+   files are reported (error log) and ignored.
+*/
+class ConfigWatcher {
+public:
+    /**
+       Loads the file and starts watching it (replacing any previous watch)
+
+       @param path Configuration file path
+       @param hangup Reload on SIGHUP
+
+       @return @em false if the file could not be loaded now (it is watched anyway)
+    */
+    static bool start(const std::string &path, bool hangup = true);
+
+    /**
+       Stops watching
+    */
+    static void stop();
+
+    /**
+       Loads a configuration file and applies it
+
+       @param path Configuration file path
+
+       @return @em false if the file cannot be read or is invalid
+    */
+    static bool load(const std::string &path);
+
+private:
+    static std::mutex mutex_;
+    static std::thread watcher_;
+    static int pipe_[2]; // wake-up: 'h' (hangup) or 's' (stop)
+    static std::atomic<int> signal_fd_; // pipe write end for the SIGHUP handler
+    static std::string path_;
+    static std::string applied_; // last content applied
+
+    static void watch(int inotify);
+    static bool reload(bool force);
+    static void onHangup(int signal);
+};
+
+}
+}
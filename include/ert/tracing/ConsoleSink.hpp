@@ -0,0 +1,150 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/types.h>
+
+#include <ert/tracing/Sink.hpp>
+
+struct iovec;
+
+namespace ert {
+namespace tracing {
+
+/**
+   Console sink configuration
+*/
+struct ConsoleSinkOptions {
+    bool timestamps = true; // prefix lines with 'YYYY-MM-DD HH:MM:SS.uuuuuu GMT: '
+    std::size_t bufferSize = 0; // per-thread buffer size (0: every line is written at once)
+    std::chrono::milliseconds flushInterval{100}; // maximum time lines stay buffered
+    bool nonBlocking = false; // drop lines (counted) instead of blocking when output is not writable
+};
+
+/**
+   Console sink: Error and more severe records go to standard error, the rest to
+   standard output. Used for Logger verbose output.
+
+   Every line is written with a single writev() call on the file descriptor, so lines
+   from different threads are not interleaved and no iostream lock is taken.
+   Optionally, lines are accumulated in per-thread buffers, written when full or by
+   a background thread every flush interval. In non-blocking mode lines are written
+   with pwritev2(RWF_NOWAIT) (poll() first where the descriptor does not support it)
+   and dropped (and counted) when a pipe is full, so a slow reader never stalls the
+   application. Buffers are written in chunks of whole lines up to PIPE_BUF, which
+   pipes take entirely or not at all; a longer line partially written is completed,
+   so lines are never cut (on a pipe, the kernel may still interleave lines longer
+   than PIPE_BUF with those of other threads).
+*/
+class ConsoleSink : public Sink {
+public:
+    explicit ConsoleSink(const ConsoleSinkOptions &options = ConsoleSinkOptions());
+    ~ConsoleSink();
+
+    ConsoleSink(const ConsoleSink&) = delete;
+    ConsoleSink& operator=(const ConsoleSink&) = delete;
+
+    void write(const Record &record) override;
+
+    /**
+       Changes the configuration, writing buffered lines first
+
+       @param options Console sink configuration
+    */
+    void configure(const ConsoleSinkOptions &options);
+
+    /**
+       Writes every thread buffer
+    */
+    void flush() override;
+
+    /**
+       @return Number of lines dropped in non-blocking mode
+    */
+    std::uint64_t drops() const {
+        return drops_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct ThreadBuffer {
+        std::mutex mutex;
+        std::string data[2]; // standard output, standard error
+
+        ThreadBuffer();
+        ~ThreadBuffer();
+    };
+
+    // Configuration, read by writers while configure() changes it:
+    std::atomic<bool> timestamps_;
+    std::atomic<std::size_t> buffer_size_;
+    std::atomic<bool> non_blocking_;
+    std::mutex configure_mutex_;
+    std::atomic<std::uint64_t> drops_;
+
+    std::thread flusher_;
+    std::mutex flusher_mutex_;
+    std::condition_variable flusher_cv_;
+    std::chrono::milliseconds flush_interval_;
+    bool stopping_;
+
+    // Buffers are per thread and process-wide (output descriptors are):
+    static std::mutex buffers_mutex_;
+    static std::vector<ThreadBuffer*> buffers_;
+    static ThreadBuffer &threadBuffer();
+    // Standard output/error write mode in non-blocking mode (see writeNoWait):
+    static std::atomic<int> nowait_mode_[3];
+    static ssize_t writeNoWait(int fd, const struct iovec *iov, int count);
+    // @return false when dropped (non-blocking mode, descriptor not writable)
+    static bool output(int fd, const struct iovec *iov, int count, std::atomic<std::uint64_t> *drops);
+    static void flush(ThreadBuffer &buffer, std::atomic<std::uint64_t> *drops); // buffer mutex must be locked
+
+    void startFlusher(); // configure_mutex_ must be locked
+    void stopFlusher(); // configure_mutex_ must be locked
+    void flushPeriodically();
+};
+
+}
+}
+
@@ -0,0 +1,142 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <sys/socket.h>
+#include <syslog.h>
+
+#include <ert/tracing/Sink.hpp>
+
+namespace ert {
+namespace tracing {
+
+/**
+   Native syslog sink configuration
+*/
+struct DatagramSinkOptions {
+    enum Format { Rfc3164, Rfc5424 };
+
+    std::string path = "/dev/log"; // AF_UNIX datagram socket of the syslog daemon
+    std::string ident; // program name (empty: process short name)
+    int facility = LOG_LOCAL1;
+    bool pid = true; // include process id (the writer one for records collected from other processes)
+    Format format = Rfc3164;
+    std::size_t batch = 64; // maximum records per sendmmsg() call
+    bool reconnect = true; // reconnect when the daemon socket goes away
+    std::chrono::milliseconds reconnectInterval{1000}; // minimum time between reconnection attempts
+    bool nonBlocking = true; // never block when the daemon is slow (ENOBUFS/EAGAIN handling applies)
+    int enobufsRetries = 0; // retries when the socket buffer is full (0: drop at once)
+    std::chrono::microseconds enobufsWait{100}; // wait between retries
+};
+
+/**
+   Syslog sink writing RFC 3164/5424 frames over its own AF_UNIX datagram socket,
+   bypassing glibc syslog(). Buffered records are sent together with sendmmsg().
+
+   Example:
+
+   ert::tracing::Logger::setSink(std::make_shared<ert::tracing::DatagramSink>(ert::tracing::DatagramSinkOptions{}));
+*/
+class DatagramSink : public Sink {
+public:
+    explicit DatagramSink(const DatagramSinkOptions &options);
+    ~DatagramSink();
+
+    DatagramSink(const DatagramSink&) = delete;
+    DatagramSink& operator=(const DatagramSink&) = delete;
+
+    void write(const Record &record) override;
+    void flush() override;
+
+    /**
+       @return Number of records dropped (socket unavailable, buffer full or frame too long)
+    */
+    std::uint64_t drops() const {
+        return drops_.load(std::memory_order_relaxed);
+    }
+
+    /**
+       @return Number of records sent
+    */
+    std::uint64_t sent() const {
+        return sent_.load(std::memory_order_relaxed);
+    }
+
+    /**
+       @return Number of send retries because the socket buffer was full (see enobufsRetries)
+    */
+    std::uint64_t retries() const {
+        return retries_.load(std::memory_order_relaxed);
+    }
+
+private:
+    DatagramSinkOptions options_;
+    std::string header_; // ' ident[pid]: ' or ' hostname ident pid - - '
+    std::string header_head_; // header up to the pid, for records of other processes
+    std::string header_tail_; // header after the pid
+    int pid_;
+    int fd_;
+    std::chrono::steady_clock::time_point last_connect_;
+
+    std::mutex mutex_;
+    std::string frames_; // pending frames, contiguous
+    std::vector<std::size_t> ends_; // end offset of every pending frame
+    std::vector<struct iovec> iovs_;
+    std::vector<struct mmsghdr> msgs_;
+
+    std::time_t cached_second_;
+    char cached_time_[32];
+    std::size_t cached_time_size_;
+
+    std::atomic<std::uint64_t> drops_;
+    std::atomic<std::uint64_t> sent_;
+    std::atomic<std::uint64_t> retries_;
+
+    bool connect();
+    void appendTimestamp(std::chrono::system_clock::time_point when);
+    void send();
+};
+
+}
+}
+
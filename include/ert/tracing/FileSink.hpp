@@ -0,0 +1,157 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ert/tracing/Sink.hpp>
+
+namespace ert {
+namespace tracing {
+
+/**
+   File sink configuration
+*/
+struct FileSinkOptions {
+    std::string path; // active file; rotated files are named path.1 (newest), path.2 ...
+    std::size_t segmentSize = 64 * 1024 * 1024; // preallocated file size, rotation by size
+    std::chrono::seconds rotationInterval{0}; // rotation by time (0: disabled)
+    unsigned int keep = 5; // number of rotated files kept
+    bool timestamps = true; // prefix lines with 'YYYY-MM-DD HH:MM:SS.uuuuuu GMT: '
+    std::chrono::milliseconds syncInterval{1000}; // asynchronous msync() period
+};
+
+/**
+   Rotating file sink writing into pre-allocated memory-mapped segments.
+
+   Writers reserve their line with an atomic fetch-add on the segment offset and
+   copy it into the mapping: no lock and no system call per record. The writer
+   overflowing the segment rotates it by swapping in the next segment, which the
+   background thread has already created and mapped (as path.next, renamed to path
+   once the files are shifted); the other writers wait for the swap. The background
+   thread also calls msync(MS_ASYNC) periodically, rotates by time and releases old
+   segments (truncated to the bytes written) once no writer uses them.
+
+   Records collected from other processes (see SharedRingCollector) are prefixed
+   with the process id of their writer: 'pid|[Level]|...'.
+
+   Example:
+
+   ert::tracing::FileSinkOptions options;
+   options.path = "/var/log/myapp.log";
+   ert::tracing::Logger::setSink(std::make_shared<ert::tracing::FileSink>(options));
+*/
+class FileSink : public Sink {
+public:
+    explicit FileSink(const FileSinkOptions &options);
+    ~FileSink();
+
+    FileSink(const FileSink&) = delete;
+    FileSink& operator=(const FileSink&) = delete;
+
+    void write(const Record &record) override;
+
+    /**
+       @return @em false if the file could not be created (records are dropped)
+    */
+    bool isOpen() const {
+        return (current_.load(std::memory_order_acquire) != nullptr);
+    }
+
+    /**
+       @return Number of records dropped (file unavailable or record longer than segment)
+    */
+    std::uint64_t drops() const {
+        return drops_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Segment {
+        int fd;
+        char *data;
+        std::size_t size;
+        std::chrono::steady_clock::time_point created;
+        std::atomic<std::size_t> offset{0}; // next reservation
+        std::atomic<std::size_t> end{0}; // bytes written when overflowed (0: not overflowed)
+        std::atomic<int> writers{0}; // writers using the segment
+    };
+
+    FileSinkOptions options_;
+    std::atomic<Segment*> current_;
+    std::atomic<std::uint64_t> drops_;
+
+    std::string next_path_; // name of the prepared segment until it becomes current
+
+    std::mutex mutex_; // rotation and segment lists
+    std::condition_variable spare_cv_; // a preparation attempt completed
+    Segment *spare_; // next segment, prepared by the syncer thread
+    bool renaming_; // current segment still named next_path_
+    std::uint64_t attempts_; // preparation attempts completed
+    std::vector<Segment*> retired_;
+    // Segment descriptors are recycled, never freed while the sink exists: a writer
+    // may still touch a stale descriptor (writers counter) just after rotation:
+    std::vector<std::unique_ptr<Segment>> segments_;
+    std::vector<Segment*> free_;
+
+    std::thread syncer_;
+    std::mutex syncer_mutex_;
+    std::condition_variable syncer_cv_;
+    bool stopping_;
+    bool wake_; // rotation happened: shift the files and prepare the next segment
+
+    Segment *createSegment(const std::string &path); // locks mutex_ (descriptor only)
+    void shiftFiles();
+    void prepare();
+    void wakeSyncer();
+    // lock must hold mutex_. Waits for the syncer when no segment is prepared, unless
+    // wait is false (the rotation is skipped then):
+    void rotate(Segment *full, std::unique_lock<std::mutex> &lock, bool wait);
+    void release(Segment *segment);
+    void releaseRetired(bool wait); // mutex_ must be locked
+    void sync();
+};
+
+}
+}
+
@@ -0,0 +1,163 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <syslog.h>
+
+#include <ert/tracing/BinaryLog.hpp>
+#include <ert/tracing/CallSite.hpp>
+
+namespace ert {
+namespace tracing {
+
+/**
+   Flight recorder configuration (see Logger::setFlightRecorder)
+*/
+struct FlightRecorderOptions {
+    int level = LOG_DEBUG; // least severe level recorded (Logger::Level), independent of the application level
+    std::size_t records = 1024; // records kept per thread (rounded up to a power of two)
+    std::size_t recordSize = 256; // bytes per record, 56 of them for metadata (longer texts are truncated)
+    std::string path; // dump file (empty: standard error)
+    bool signals = true; // dump on SIGSEGV, SIGABRT, SIGBUS, SIGFPE and SIGILL
+    bool dumpOnTerminate = false; // dump from Logger::terminate()
+};
+
+/**
+   In-memory flight recorder: every thread keeps its last records in a fixed ring,
+   so the context preceding a crash is available even when that level is not logged.
+
+   Rings are written by their thread only, without lock and with no allocation once
+   created. Call-site statements (ERT_LOGF, ERT_LOG_DEBUG ...) store the raw arguments
+   (see BinaryLog), other statements their text; formatting happens on dump. Slots are
+   sequence-stamped (seqlock), so a dump running concurrently skips records being
+   overwritten. Rings of finished threads are reused by new threads and their records
+   are kept until then.
+
+   Dumps render the records of every thread in time order, as the usual text lines
+   prefixed with timestamp and thread id. They are async-signal-safe: no allocation,
+   no lock, only open/write/close system calls. Signal handlers run on an alternate
+   stack, installed for the configuring thread and every recording thread (unless the
+   application installed its own), so stack overflows are dumped too.
+*/
+class FlightRecorder {
+public:
+    static constexpr std::size_t HeaderSize = 56; // sequence, time, thread, level/line/size, file, function, format
+    static constexpr std::size_t MaxRecordSize = 1024;
+
+    /**
+       Sets the configuration. Ring geometry (records and recordSize) is fixed by
+       the first call; later calls only change the dump configuration.
+
+       @param options Recorder configuration
+    */
+    static void configure(const FlightRecorderOptions &options);
+
+    /**
+       Records a text
+
+       @param level Record level
+       @param file Source file (must remain valid: normally a string literal)
+       @param line Source line
+       @param function Source function (must remain valid)
+       @param text Record text
+       @param size Text size
+    */
+    static void record(int level, const char *file, int line, const char *function, const char *text, std::size_t size);
+
+    /**
+       Records a call-site statement with its raw arguments
+
+       @param site Call site
+       @param format Statement format (must remain valid: string literal)
+       @param args Format arguments
+    */
+    template <typename... Args>
+    static void record(const CallSite &site, const char *format, const Args &... args) {
+        char payload[MaxRecordSize];
+        binary::FixedBuffer out{payload + 1, payload + payload_size_.load(std::memory_order_relaxed)};
+        char *complete = out.p; // end of the last argument fully encoded
+        std::uint8_t argc = 0;
+        auto encode = [&](const auto &arg) {
+            if (out.overflow) return;
+            binary::encodeArgument(out, arg);
+            if (!out.overflow) {
+                argc++;
+                complete = out.p;
+            }
+        };
+        (void)encode;
+        (encode(args), ...);
+        payload[0] = (char)argc;
+        commit(site.level, site.file, site.line, site.function, format, payload, complete - payload);
+    }
+
+    /**
+       Dumps every thread ring into the configured path (or standard error).
+       Async-signal-safe.
+
+       @return @em false if the dump file cannot be opened, or a dump is already running
+    */
+    static bool dump();
+
+    /**
+       Dumps every thread ring into a file descriptor. Async-signal-safe.
+
+       @param fd Output file descriptor
+
+       @return @em false if a dump is already running
+    */
+    static bool dump(int fd);
+
+private:
+    struct Ring;
+
+    static std::atomic<Ring*> rings_; // every ring ever created (never freed)
+    static std::atomic<std::size_t> words_; // words per record (0: not configured)
+    static std::size_t capacity_; // records per ring
+    static std::atomic<std::size_t> payload_size_;
+
+    static void commit(int level, const char *file, int line, const char *function, const char *format, const char *payload, std::size_t size);
+    static Ring *ring(); // calling thread ring (nullptr when not configured)
+    static void onSignal(int signal);
+};
+
+}
+}
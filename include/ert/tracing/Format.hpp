@@ -0,0 +1,189 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace ert {
+namespace tracing {
+namespace format {
+
+template <typename T> struct unsupported : std::false_type {};
+
+/**
+   Appends the text representation of a formatting argument.
+   Argument types are resolved at compile time: unsupported types fail to build
+   instead of producing undefined behaviour as variadic C functions do.
+
+   Supported: bool, char, integral and floating point numbers, enumerations,
+   C strings, std::string, std::string_view and pointers.
+
+   @param out Destination buffer
+   @param value Argument
+*/
+template <typename T>
+void appendArgument(std::string &out, const T &value) {
+    using D = std::decay_t<T>;
+
+    if constexpr (std::is_same_v<D, bool>) {
+        out.append(value ? "true":"false");
+    }
+    else if constexpr (std::is_same_v<D, char>) {
+        out.push_back(value);
+    }
+    else if constexpr (std::is_integral_v<D> || std::is_floating_point_v<D>) {
+        char aux[64];
+        auto res = std::to_chars(aux, aux + sizeof(aux), value);
+        out.append(aux, res.ptr - aux);
+    }
+    else if constexpr (std::is_enum_v<D>) {
+        appendArgument(out, static_cast<std::underlying_type_t<D>>(value));
+    }
+    else if constexpr (std::is_same_v<D, const char*> || std::is_same_v<D, char*>) {
+        const char *str = value;
+        out.append(str ? str:"(null)");
+    }
+    else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        std::string_view view(value);
+        out.append(view.data(), view.size());
+    }
+    else if constexpr (std::is_pointer_v<D> || std::is_null_pointer_v<D>) {
+        char aux[2 + 2 * sizeof(void*)] = { '0', 'x' };
+        auto res = std::to_chars(aux + 2, aux + sizeof(aux), (std::uintptr_t)(const void*)value, 16);
+        out.append(aux, res.ptr - aux);
+    }
+    else {
+        static_assert(unsupported<T>::value, "ert::tracing::format: unsupported argument type");
+    }
+}
+
+/**
+   Appends format text up to the next '{}' placeholder, resolving '{{' and '}}' escapes.
+
+   @return Pointer just after the placeholder found, or @em nullptr when the end of the
+   format is reached
+*/
+inline const char *appendLiteral(std::string &out, const char *format) {
+    const char *p = format;
+    for (;;) {
+        const char *start = p;
+        while (*p && *p != '{' && *p != '}') p++;
+        out.append(start, p - start);
+
+        if (!*p) return nullptr;
+        if (p[0] == '{' && p[1] == '}') return p + 2;
+        if (p[0] == p[1]) p++; // escaped brace
+        out.push_back(*p++);
+    }
+}
+
+/**
+   Appends format text without remaining arguments.
+*/
+inline void append(std::string &out, const char *format) {
+    while ((format = appendLiteral(out, format))) out.append("{}");
+}
+
+/**
+   Appends text formatted with '{}' placeholders (fmtlib syntax without format specs).
+   Placeholders without argument are kept literally and extra arguments are ignored.
+
+   Example: append(out, "x={} y={}", 1, "two") appends "x=1 y=two"
+
+   @param out Destination buffer
+   @param format Format text
+   @param first, rest Arguments
+*/
+template <typename First, typename... Rest>
+void append(std::string &out, const char *format, const First &first, const Rest &... rest) {
+    format = appendLiteral(out, format);
+    if (!format) return;
+    appendArgument(out, first);
+    append(out, format, rest...);
+}
+
+/**
+   Counts '{}' placeholders. Usable at compile time.
+*/
+constexpr std::size_t placeholders(const char *format) {
+    std::size_t result = 0;
+    for (const char *p = format; *p; p++) {
+        if ((p[0] == '{' || p[0] == '}') && p[1] == p[0]) p++;
+        else if (p[0] == '{' && p[1] == '}') {
+            result++;
+            p++;
+        }
+    }
+    return result;
+}
+
+template <typename T> struct identity { using type = T; };
+
+/**
+   Format text of the Logger shortcuts (debugf() ...), for sizeof...(Args) arguments.
+   Built as C++20 or later, the text must be a literal whose placeholders are counted at
+   compile time (consteval constructor): a mismatch fails to build, as with ERT_LOGF.
+   Built as C++17 it is not checked.
+*/
+template <typename... Args>
+struct Checked {
+#if defined(__cpp_consteval) && __cpp_consteval >= 201811L
+    template <std::size_t N>
+    consteval Checked(const char (&format)[N]) : text(format) {
+        if (placeholders(format) != sizeof...(Args)) throw "format placeholders do not match the number of arguments";
+    }
+#else
+    constexpr Checked(const char *format) : text(format) {}
+#endif
+
+    const char *text;
+};
+
+/**
+   Checked format for the given argument types (not deduced from the format)
+*/
+template <typename... Args>
+using checked = Checked<typename identity<Args>::type...>;
+
+}
+}
+}
+
@@ -35,14 +35,55 @@ SOFTWARE.
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
 
 #include <syslog.h>
 
+#include <ert/tracing/BinaryLog.hpp>
+#include <ert/tracing/CallSite.hpp>
+#include <ert/tracing/Clock.hpp>
+#include <ert/tracing/Configuration.hpp>
+#include <ert/tracing/ConsoleSink.hpp>
+#include <ert/tracing/FlightRecorder.hpp>
+#include <ert/tracing/Format.hpp>
+#include <ert/tracing/RateLimiter.hpp>
+#include <ert/tracing/Sink.hpp>
+#include <ert/tracing/SinkWorker.hpp>
+#include <ert/tracing/Stats.hpp>
+#include <ert/tracing/Structured.hpp>
+
 // Logger macros
 #define ERT_FILE_LOCATION (const char *)__FILE__,(const int)__LINE__,(const char*)__func__
 
+// Compile-time level: statements for less severe levels are removed from the build
+// (0..7, see Logger::Level). Error and more severe levels are always compiled in.
+// Normally set through CMake: -DERT_LOGGER_COMPILE_MIN_LEVEL=Informational
+#ifndef ERT_LOGGER_COMPILE_MIN_LEVEL
+#define ERT_LOGGER_COMPILE_MIN_LEVEL 7
+#endif
+
+// Branch prediction hints:
+#if defined(__GNUC__)
+#define ERT_LIKELY(x) __builtin_expect(!!(x), 1)
+#define ERT_UNLIKELY(x) __builtin_expect(!!(x), 0)
+// From a constant level: likely for Error and more severe levels, unlikely below
+#define ERT_LEVEL_HINT(level, x) __builtin_expect(!!(x), ((level) <= ert::tracing::Logger::Error) ? 1 : 0)
+#else
+#define ERT_LIKELY(x) (x)
+#define ERT_UNLIKELY(x) (x)
+#define ERT_LEVEL_HINT(level, x) (x)
+#endif
+
 // Block-level-protected macros:
 //
 // Example:
@@ -54,18 +95,114 @@ SOFTWARE.
 //   ert::tracing::Logger::debug(msg, ERT_FILE_LOCATION);
 // );
 //
+// Blocks for levels under ERT_LOGGER_COMPILE_MIN_LEVEL are discarded at compile time.
+//
+// An optional category name (string literal) may be provided as first argument:
+//
+// LOGDEBUG("http2",
+//   ...
+// );
+//
+#define ERT_LOGGER_BLOCK_(level, hint, a) if constexpr (ert::tracing::Logger::isCompiled(level)) { \
+    if (hint(ert::tracing::Logger::isCaptured(level) && ert::tracing::Logger::isSampled(level))) {a;} }
+#define ERT_LOGGER_CATEGORY_BLOCK_(level, hint, category, a) if constexpr (ert::tracing::Logger::isCompiled(level)) { \
+    static ert::tracing::Category ert_category_(category); \
+    if (hint(ert::tracing::Logger::isCaptured(level, ert_category_) && ert::tracing::Logger::isSampled(level))) { ert::tracing::Logger::CategoryScope ert_category_scope_(ert_category_); a; } }
+#define ERT_LOGGER_SELECT_(_1, _2, name, ...) name
+#define ERT_LOGGER_GUARD_(level, hint, ...) ERT_LOGGER_SELECT_(__VA_ARGS__, ERT_LOGGER_CATEGORY_BLOCK_, ERT_LOGGER_BLOCK_, 0)(level, hint, __VA_ARGS__)
+//
 // LOG_EMERG =   0      system is unusable                   Emergency (emerg)
+#define LOGEMERGENCY(...) ERT_LOGGER_GUARD_(ert::tracing::Logger::Emergency, ERT_LIKELY, __VA_ARGS__)
 // LOG_ALERT =   1      action must be taken immediately     Alert (alert)
+#define LOGALERT(...) ERT_LOGGER_GUARD_(ert::tracing::Logger::Alert, ERT_LIKELY, __VA_ARGS__)
 // LOG_CRIT =    2      critical conditions                  Critical (crit)
+#define LOGCRITICAL(...) ERT_LOGGER_GUARD_(ert::tracing::Logger::Critical, ERT_LIKELY, __VA_ARGS__)
 // LOG_ERR =     3      error conditions                     Error (err)
+#define LOGERROR(...) ERT_LOGGER_GUARD_(ert::tracing::Logger::Error, ERT_LIKELY, __VA_ARGS__)
 // LOG_WARNING = 4      warning conditions                   Warning (warning)
-#define LOGWARNING(a) if (ert::tracing::Logger::isActive (ert::tracing::Logger::Warning)) {a;}
+#define LOGWARNING(...) ERT_LOGGER_GUARD_(ert::tracing::Logger::Warning, ERT_UNLIKELY, __VA_ARGS__)
 // LOG_NOTICE =  5      normal but significant condition     Notice (notice)
-#define LOGNOTICE(a) if (ert::tracing::Logger::isActive (ert::tracing::Logger::Notice)) {a;}
+#define LOGNOTICE(...) ERT_LOGGER_GUARD_(ert::tracing::Logger::Notice, ERT_UNLIKELY, __VA_ARGS__)
 // LOG_INFO =    6      informational                        Informational (info)
-#define LOGINFORMATIONAL(a) if (ert::tracing::Logger::isActive (ert::tracing::Logger::Informational)) {a;}
+#define LOGINFORMATIONAL(...) ERT_LOGGER_GUARD_(ert::tracing::Logger::Informational, ERT_UNLIKELY, __VA_ARGS__)
 // LOG_DEBUG =   7      debug-level messages                 Debug (debug)
-#define LOGDEBUG(a) if (ert::tracing::Logger::isActive (ert::tracing::Logger::Debug)) {a;}
+#define LOGDEBUG(...) ERT_LOGGER_GUARD_(ert::tracing::Logger::Debug, ERT_UNLIKELY, __VA_ARGS__)
+
+// Sampled blocks: only one in every n executions (per thread) is processed when the
+// level is active, starting with the first one. Skipped blocks are not evaluated at all
+// and are counted (Logger::stats()). An optional category may follow n.
+//
+// LOGDEBUG_SAMPLED(1000,
+//   ert::tracing::Logger::debug(msg, ERT_FILE_LOCATION);
+// );
+//
+#define ERT_LOGGER_SAMPLED_BLOCK_(level, hint, n, a) if constexpr (ert::tracing::Logger::isCompiled(level)) { \
+    static thread_local std::uint32_t ert_sample_skip_ = 0; \
+    if (hint(ert::tracing::Logger::isCaptured(level) && ert::tracing::Logger::isSampled(level, ert_sample_skip_, n))) {a;} }
+#define ERT_LOGGER_SAMPLED_CATEGORY_BLOCK_(level, hint, n, category, a) if constexpr (ert::tracing::Logger::isCompiled(level)) { \
+    static ert::tracing::Category ert_category_(category); \
+    static thread_local std::uint32_t ert_sample_skip_ = 0; \
+    if (hint(ert::tracing::Logger::isCaptured(level, ert_category_) && ert::tracing::Logger::isSampled(level, ert_sample_skip_, n))) { ert::tracing::Logger::CategoryScope ert_category_scope_(ert_category_); a; } }
+#define ERT_LOGGER_SAMPLED_GUARD_(level, hint, n, ...) ERT_LOGGER_SELECT_(__VA_ARGS__, ERT_LOGGER_SAMPLED_CATEGORY_BLOCK_, ERT_LOGGER_SAMPLED_BLOCK_, 0)(level, hint, n, __VA_ARGS__)
+#define LOGWARNING_SAMPLED(n, ...) ERT_LOGGER_SAMPLED_GUARD_(ert::tracing::Logger::Warning, ERT_UNLIKELY, n, __VA_ARGS__)
+#define LOGNOTICE_SAMPLED(n, ...) ERT_LOGGER_SAMPLED_GUARD_(ert::tracing::Logger::Notice, ERT_UNLIKELY, n, __VA_ARGS__)
+#define LOGINFORMATIONAL_SAMPLED(n, ...) ERT_LOGGER_SAMPLED_GUARD_(ert::tracing::Logger::Informational, ERT_UNLIKELY, n, __VA_ARGS__)
+#define LOGDEBUG_SAMPLED(n, ...) ERT_LOGGER_SAMPLED_GUARD_(ert::tracing::Logger::Debug, ERT_UNLIKELY, n, __VA_ARGS__)
+
+// Call-site macros:
+//
+// A static constexpr call site is created for every statement, so the record prefix
+// '[Level]|file:line(function)|' (with file basename) is rendered at compile time.
+// Level is checked before evaluating arguments. Format placeholders '{}' must match
+// the number of arguments (checked at compile time). Statements under
+// ERT_LOGGER_COMPILE_MIN_LEVEL are discarded at compile time.
+//
+// Example:
+//
+// ERT_LOG_DEBUG("x={} y={}", x, y);
+// ERT_LOG(ert::tracing::Logger::Error, msg);
+//
+#define ERT_LOG(level, text) do { \
+    if constexpr (ert::tracing::Logger::isCompiled(level)) { \
+        ERT_CALL_SITE(ert_call_site_, level); \
+        if (ERT_LEVEL_HINT(level, ert::tracing::Logger::isCaptured(level) && ert::tracing::Logger::isSampled(level))) ert::tracing::Logger::log(ert_call_site_, text); \
+    } \
+} while(0)
+
+#define ERT_LOGF_FORMAT_(format, ...) format
+#define ERT_LOGF(level, ...) do { \
+    static_assert(ert::tracing::format::placeholders(ERT_LOGF_FORMAT_(__VA_ARGS__, 0)) + 1 == std::tuple_size<decltype(std::forward_as_tuple(__VA_ARGS__))>::value, \
+                  "ERT_LOGF: format placeholders do not match the number of arguments"); \
+    if constexpr (ert::tracing::Logger::isCompiled(level)) { \
+        ERT_CALL_SITE(ert_call_site_, level); \
+        if (ERT_LEVEL_HINT(level, ert::tracing::Logger::isCaptured(level) && ert::tracing::Logger::isSampled(level))) ert::tracing::Logger::logf(ert_call_site_, __VA_ARGS__); \
+    } \
+} while(0)
+
+// One in every n statements (per thread), see LOGDEBUG_SAMPLED:
+#define ERT_LOGF_SAMPLED(level, n, ...) do { \
+    static_assert(ert::tracing::format::placeholders(ERT_LOGF_FORMAT_(__VA_ARGS__, 0)) + 1 == std::tuple_size<decltype(std::forward_as_tuple(__VA_ARGS__))>::value, \
+                  "ERT_LOGF_SAMPLED: format placeholders do not match the number of arguments"); \
+    if constexpr (ert::tracing::Logger::isCompiled(level)) { \
+        ERT_CALL_SITE(ert_call_site_, level); \
+        static thread_local std::uint32_t ert_sample_skip_ = 0; \
+        if (ERT_UNLIKELY(ert::tracing::Logger::isCaptured(level) && ert::tracing::Logger::isSampled(level, ert_sample_skip_, n))) ert::tracing::Logger::logf(ert_call_site_, __VA_ARGS__); \
+    } \
+} while(0)
+
+#define ERT_LOG_DEBUG(...) ERT_LOGF(ert::tracing::Logger::Debug, __VA_ARGS__)
+#define ERT_LOG_INFORMATIONAL(...) ERT_LOGF(ert::tracing::Logger::Informational, __VA_ARGS__)
+#define ERT_LOG_NOTICE(...) ERT_LOGF(ert::tracing::Logger::Notice, __VA_ARGS__)
+#define ERT_LOG_WARNING(...) ERT_LOGF(ert::tracing::Logger::Warning, __VA_ARGS__)
+#define ERT_LOG_ERROR(...) ERT_LOGF(ert::tracing::Logger::Error, __VA_ARGS__)
+#define ERT_LOG_CRITICAL(...) ERT_LOGF(ert::tracing::Logger::Critical, __VA_ARGS__)
+#define ERT_LOG_ALERT(...) ERT_LOGF(ert::tracing::Logger::Alert, __VA_ARGS__)
+#define ERT_LOG_EMERGENCY(...) ERT_LOGF(ert::tracing::Logger::Emergency, __VA_ARGS__)
+
+#define ERT_LOG_DEBUG_SAMPLED(n, ...) ERT_LOGF_SAMPLED(ert::tracing::Logger::Debug, n, __VA_ARGS__)
+#define ERT_LOG_INFORMATIONAL_SAMPLED(n, ...) ERT_LOGF_SAMPLED(ert::tracing::Logger::Informational, n, __VA_ARGS__)
+#define ERT_LOG_NOTICE_SAMPLED(n, ...) ERT_LOGF_SAMPLED(ert::tracing::Logger::Notice, n, __VA_ARGS__)
+#define ERT_LOG_WARNING_SAMPLED(n, ...) ERT_LOGF_SAMPLED(ert::tracing::Logger::Warning, n, __VA_ARGS__)
 
 namespace ert {
 namespace tracing {
@@ -77,6 +214,87 @@ namespace tracing {
  */
 std::string getLocaltime();
 
+/**
+   Buffer size needed by getLocaltime() character version, including null terminator
+*/
+constexpr std::size_t LocaltimeSize = 31;
+
+/**
+   Allocation-free version of getLocaltime() writing into a caller buffer.
+   The 'YYYY-MM-DD HH:MM:SS' part is cached per thread and only rendered again
+   when the second changes; microseconds are patched on every call.
+
+   @param buffer Destination buffer (LocaltimeSize bytes are enough)
+   @param size Destination buffer size
+   @param when Time point to render (current time by default)
+
+   @return Number of characters written (null terminator excluded), 0 when buffer is too small
+ */
+std::size_t getLocaltime(char *buffer, std::size_t size, std::chrono::system_clock::time_point when);
+inline std::size_t getLocaltime(char *buffer, std::size_t size) {
+    return getLocaltime(buffer, size, std::chrono::system_clock::now());
+}
+
+class RecordQueue;
+class Logger;
+
+/**
+   Log category slot. Categories allow specific levels for subsystems
+   (Logger::setLevel("http2", Logger::Debug)) while the rest of the application
+   keeps the global level.
+
+   Slots are normally static at every call site (LOG* macros with category):
+   they cache the category level, which is looked up again (by name, under lock)
+   only when any level changes.
+*/
+class Category {
+public:
+    /**
+       Constructor
+
+       @param name Category name (must remain valid: normally a string literal)
+    */
+    constexpr explicit Category(const char *name) : name_(name), cache_(0) {}
+
+    const char *name() const {
+        return name_;
+    }
+
+private:
+    friend class Logger;
+    const char *name_;
+    std::atomic<std::uint64_t> cache_; // generation << 8 | level (generation 0: never resolved)
+};
+
+/**
+   Asynchronous logging configuration.
+   Records are copied into a bounded lock-free queue and written to syslog by a
+   background drain thread, so the caller never blocks on the syslog socket.
+
+   When the queue is full the overflow policy applies; dropped records are counted
+   (Logger::stats()) and summarized in a warning once the queue is drained.
+
+   Example: ert::tracing::Logger::initialize("myapp", -1, -1, ert::tracing::AsyncOptions{16384});
+*/
+struct AsyncOptions {
+    /**
+       Queue full behaviour
+    */
+    enum Overflow {
+        DropNewest, // the record being logged is dropped
+        DropOldest, // the oldest queued record is dropped to make room
+        Block, // the caller waits for room up to blockTimeout, then drops its record
+        DropBelow // records less severe than protectLevel are dropped, the others are written by the caller
+    };
+
+    std::size_t capacity = 8192; // number of queued records (rounded up to a power of two)
+    std::size_t recordSize = 512; // bytes reserved in advance for each queued record
+    std::chrono::milliseconds idleWait{10}; // maximum drain thread sleep when queue is empty
+    Overflow overflow = DropNewest;
+    std::chrono::milliseconds blockTimeout{100}; // Block policy maximum wait
+    int protectLevel = LOG_ERR; // DropBelow policy: this level and more severe ones always get through
+};
+
 /**
    Facility to generate application logs
 */
@@ -102,21 +320,210 @@ public:
     */
     static void initialize(const char *programName = nullptr, int options = -1, int facility = -1) {
         openlog(programName, (options != -1) ? options:(LOG_CONS/* | LOG_PERROR*/), (facility != -1) ? facility:LOG_LOCAL1);
-        initialized_ = true;
+        initialized_.store(true, std::memory_order_release);
     }
 
     /**
-       Terminates syslog system
+       Initializes syslog system in asynchronous mode: log() only copies the record
+       into a bounded queue which is drained into syslog by a background thread.
+       Records are dropped (and counted) when the queue is full.
+
+       @param Program name (undefined by default)
+       @param Syslog options (-1 for LOG_CONS)
+       @param Syslog facility (-1 for LOG_LOCAL1)
+       @param async Asynchronous mode configuration
+    */
+    static void initialize(const char *programName, int options, int facility, const AsyncOptions &async);
+
+    /**
+       Terminates syslog system.
+       In asynchronous mode, pending records are flushed before closing.
     */
-    static void terminate() {
-        if(initialized_) closelog();
+    static void terminate();
+
+    /**
+       @return @em true when asynchronous mode is running
+    */
+    static bool isAsync() {
+        return (queue_.load(std::memory_order_acquire) != nullptr);
+    }
+
+    /**
+       @return Number of records dropped in asynchronous mode because the queue was full
+    */
+    static std::uint64_t asyncDrops() {
+        return async_drops_.load(std::memory_order_relaxed);
+    }
+
+    /**
+       Snapshot of the logger metrics: per-level emitted records, bytes, drops and
+       suppressions, and the log call latency histogram (see measureLatency).
+       Counters are kept per thread, so recording them needs no shared write.
+
+       Example: response.body = ert::tracing::Logger::stats().prometheus();
+
+       @return Metrics summed over every thread
+    */
+    static Stats stats() {
+        return stats::snapshot();
+    }
+
+    /**
+       Enables the log call latency histogram (disabled by default, as it takes
+       two clock readings per emitted record)
+
+       @param enabled Boolean about measuring latency
+    */
+    static void measureLatency(bool enabled = true) {
+        if (enabled) state_.word.fetch_or(LatencyFlag, std::memory_order_acq_rel);
+        else state_.word.fetch_and(~LatencyFlag, std::memory_order_acq_rel);
+    }
+
+    /**
+       Enables the flight recorder: records up to its own level are kept in per-thread
+       in-memory rings, even when that level is not logged, and dumped on crash signals,
+       on demand (dumpFlightRecorder) or on terminate() (see FlightRecorder).
+
+       Example: keep the last 4096 Debug records per thread while logging at Warning:
+       ert::tracing::FlightRecorderOptions options;
+       options.records = 4096;
+       ert::tracing::Logger::setFlightRecorder(options);
+
+       @param options Flight recorder configuration
+    */
+    static void setFlightRecorder(const FlightRecorderOptions &options);
+
+    /**
+       Stops recording (records kept so far may still be dumped)
+    */
+    static void unsetFlightRecorder() {
+        state_.word.fetch_and(~(RecorderMask << RecorderShift), std::memory_order_acq_rel);
+    }
+
+    /**
+       Dumps the flight recorder into its configured path (standard error by default)
+
+       @return @em false if the dump file cannot be opened
+    */
+    static bool dumpFlightRecorder() {
+        return FlightRecorder::dump();
+    }
+
+    /**
+       Sets the output sink, replacing glibc syslog() (for example a DatagramSink).
+       The main output is the sink registered as "syslog" (see addSink()), so its level
+       and worker configuration are kept; the entry is registered again if it was removed.
+       It is safe to change the sink while other threads are logging: the previous
+       one is released once no thread writes to it.
+
+       @param sink Output sink (nullptr restores glibc syslog() output, a SyslogSink)
+    */
+    static void setSink(std::shared_ptr<Sink> sink);
+
+    /**
+       Registers an additional sink: records are formatted once and delivered, by
+       reference to the same buffer, to every registered sink whose level admits them.
+       Sinks with a worker are fed from their own thread and queue, so a slow sink
+       does not stall the application or the other sinks (records are dropped and
+       counted when its queue is full).
+       Sink levels only restrict the records admitted by the logger levels.
+
+       The default outputs are registered too: "syslog" (the main output, a SyslogSink
+       unless replaced by setSink()) and "console" (the verbose output, which only
+       receives records while verbose). Passing a null sink with an existing name keeps
+       its sink and changes its options, for example to give syslog its own worker.
+
+       Example:
+
+       ert::tracing::SinkOptions options;
+       options.level = ert::tracing::Logger::Error;
+       options.worker = true;
+       ert::tracing::Logger::addSink("file", std::make_shared<ert::tracing::FileSink>(fileOptions), options);
+
+       @param name Sink name (a sink already registered with that name is replaced)
+       @param sink Sink (nullptr to reconfigure the sink registered with that name)
+       @param options Sink level and worker configuration
+    */
+    static void addSink(const std::string &name, std::shared_ptr<Sink> sink, const SinkOptions &options = SinkOptions());
+
+    /**
+       Unregisters a sink (pending records of its worker are delivered first)
+
+       @param name Sink name
+
+       @return @em false if no sink is registered with that name
+    */
+    static bool removeSink(const std::string &name);
+
+    /**
+       Enables deferred binary logging (see BinaryLog): formatted call-site statements
+       (ERT_LOGF, ERT_LOG_DEBUG ... ERT_LOG_EMERGENCY) are not formatted but stored raw
+       into the binary file, to be rendered offline by 'ert_logger_decode'.
+       Other statements keep the usual output.
+
+       @param path Binary file path (empty to disable binary logging)
+       @param bufferSize Per-thread buffer size
+
+       @return Boolean about successful operation
+    */
+    static bool setBinary(const std::string &path, std::size_t bufferSize = 65536);
+
+    /**
+       Enables per-call-site rate limiting and duplicate suppression (see RateLimiter).
+       Suppressed records are counted and reported per call site as a single
+       'suppressed N similar messages' record, when the site emits again, or from a
+       background thread every flushInterval once the site window expired (and on terminate).
+
+       @param options Rate limiting configuration
+    */
+    static void setRateLimit(const RateLimitOptions &options);
+
+    /**
+       Disables rate limiting, reporting pending suppressed records
+    */
+    static void unsetRateLimit();
+
+    /**
+       @return Number of records suppressed by rate limiting
+    */
+    static std::uint64_t suppressed() {
+        return rate_limiter_.total();
+    }
+
+    /**
+       Reports pending suppressed records counters, one record per call site
+    */
+    static void reportSuppressed();
+
+    /**
+       Record formats:
+       Text:   [Level]|file:line(function)|text key=value ...
+       Json:   {"level":"Level","file":"file","line":line,"function":"function","msg":"text","key":value ...}
+       Logfmt: level=Level file=file line=line function=function msg="text" key=value ...
+    */
+    enum Format { Text, Json, Logfmt };
+
+    /**
+       Sets the record format for every statement (text by default)
+
+       @param format Record format
+    */
+    static void setFormat(const Format format) {
+        format_.store(format, std::memory_order_relaxed);
+    }
+
+    /**
+       @return Record format
+    */
+    static Format getFormat() {
+        return (Format)format_.load(std::memory_order_relaxed);
     }
 
     /**
        @return Current application trace level
     */
     static Level getLevel() {
-        return level_;
+        return (Level)(state_.word.load(std::memory_order_acquire) & LevelMask);
     }
 
     /**
@@ -126,8 +533,23 @@ public:
        @param enabled Boolean about activating verbose output
     */
     static void verbose(bool enabled = true) {
-        std::lock_guard<std::mutex> guard(mutex_);
-        verbose_ = enabled;
+        if (enabled) state_.word.fetch_or(VerboseFlag, std::memory_order_acq_rel);
+        else state_.word.fetch_and(~VerboseFlag, std::memory_order_acq_rel);
+    }
+
+    /**
+       Enables verbose output with a specific console configuration
+       (buffering, non-blocking mode, see ConsoleSink).
+
+       @param options Console sink configuration
+    */
+    static void verbose(const ConsoleSinkOptions &options);
+
+    /**
+       @return Verbose flag
+    */
+    static bool isVerbose() {
+        return (state_.word.load(std::memory_order_acquire) & VerboseFlag);
     }
 
     /**
@@ -138,8 +560,11 @@ public:
     */
     static void setLevel(const Level level) {
         std::lock_guard<std::mutex> guard(mutex_);
-        level_ = (level <= Error) ? Error : level;
-        setlogmask(LOG_UPTO(level_)); // just in case syslog is used directly
+        const Level value = (level <= Error) ? Error : level;
+        // Generation is increased so categories without own level refresh their cache:
+        std::uint64_t current = state_.word.load(std::memory_order_relaxed);
+        while (!state_.word.compare_exchange_weak(current, ((current & ~LevelMask) | (std::uint64_t)value) + GenerationUnit, std::memory_order_acq_rel)) {}
+        setlogmask(LOG_UPTO(value)); // just in case syslog is used directly
     }
 
     /**
@@ -152,6 +577,49 @@ public:
     */
     static bool setLevel(const std::string &level);
 
+    /**
+       Sets the trace level for a category (see Category), overriding the
+       application level for statements of that category.
+
+       @param category Category name
+       @param level Level desired
+    */
+    static void setLevel(const std::string &category, const Level level);
+
+    /**
+       Removes the category level, so the application level applies again
+
+       @param category Category name
+    */
+    static void unsetLevel(const std::string &category);
+
+    /**
+       @param category Category name
+
+       @return Category trace level (application level when not configured)
+    */
+    static Level getLevel(const std::string &category);
+
+    /**
+       Least severe level compiled in (see ERT_LOGGER_COMPILE_MIN_LEVEL)
+    */
+    static constexpr Level CompiledLevel = (ERT_LOGGER_COMPILE_MIN_LEVEL < LOG_ERR) ? Error : (Level)ERT_LOGGER_COMPILE_MIN_LEVEL;
+
+    /**
+       Checks if a level is compiled in (see ERT_LOGGER_COMPILE_MIN_LEVEL).
+       Error and more severe levels are always compiled in.
+
+       @param level Level to check
+
+       @return @em true when statements for this level are kept in the build
+    */
+    static constexpr bool isCompiled(const Level level) {
+        return (level <= CompiledLevel);
+    }
+    static constexpr bool isCompiled(int level) {
+        return isCompiled((Level)level);
+    }
+
     /**
        Checks if application trace level is over provided one.
        For example, an info-level is active when application level is over (or equals) it: info, debug
@@ -161,12 +629,171 @@ public:
        @return @em true For levels with priority over application configured one, false in other case.
     */
     static bool isActive(const Level level) {
-        return (level <= Error) ? true : (level <= level_);
+        if (level <= Error) return true;
+        return (isCompiled(level) && (std::uint32_t)level <= (state_.word.load(std::memory_order_relaxed) & LevelMask));
     }
     static bool isActive(int level) {
         return isActive((Level)level);
     }
 
+    /**
+       Checks if statements of a level must be evaluated: the level is active (isActive)
+       or kept by the flight recorder (see setFlightRecorder). This is the gate of the
+       LOG* and call-site macros.
+
+       @param level Level to check
+
+       @return @em true when records of this level are output or recorded
+    */
+    static bool isCaptured(const Level level) {
+        if (level <= Error) return true;
+        std::uint64_t state = state_.word.load(std::memory_order_relaxed);
+        return (isCompiled(level) && ((std::uint32_t)level <= (state & LevelMask) || (std::uint32_t)level < ((state >> RecorderShift) & RecorderMask)));
+    }
+    static bool isCaptured(int level) {
+        return isCaptured((Level)level);
+    }
+
+    /**
+       Checks if a level is active for a category.
+       The category level is cached in the Category slot and only looked up again
+       when any level changes (generation counter), so this costs two atomic loads.
+
+       @param level Level to check
+       @param category Category slot (normally static at call site, see LOG* macros)
+
+       @return @em true For levels with priority over category configured one, false in other case.
+    */
+    static bool isActive(const Level level, Category &category) {
+        if (level <= Error) return true;
+        if (!isCompiled(level)) return false;
+        std::uint64_t cached = category.cache_.load(std::memory_order_relaxed);
+        if (ERT_UNLIKELY((cached >> 8) != (state_.word.load(std::memory_order_relaxed) >> GenerationShift))) cached = refresh(category);
+        return ((std::uint64_t)level <= (cached & LevelMask));
+    }
+    static bool isActive(int level, Category &category) {
+        return isActive((Level)level, category);
+    }
+
+    /**
+       Checks if statements of a level must be evaluated for a category: the level is
+       active for the category or kept by the flight recorder (see isCaptured).
+
+       @param level Level to check
+       @param category Category slot (normally static at call site, see LOG* macros)
+
+       @return @em true when records of this level are output or recorded
+    */
+    static bool isCaptured(const Level level, Category &category) {
+        return (isActive(level, category) || isRecorded(level));
+    }
+    static bool isCaptured(int level, Category &category) {
+        return isCaptured((Level)level, category);
+    }
+
+    /**
+       Sets a sampling rate for a level: statement gates (LOG* blocks and call-site
+       macros) of that level admit each execution with the given probability, decided
+       with a per-thread xorshift generator before anything is evaluated. Statements
+       skipped are counted (Logger::stats()) so volumes can be extrapolated.
+       Functions like logf() or debug() are not sampled themselves (they are normally
+       called from sampled blocks), nor are *_SAMPLED statements, which use their own rate.
+
+       Example: keep 1% of Debug statements: setSampling(ert::tracing::Logger::Debug, 0.01)
+
+       @param level Level sampled
+       @param rate Probability to keep a statement (1: no sampling)
+    */
+    static void setSampling(const Level level, double rate);
+
+    /**
+       Applies a runtime configuration (application and category levels, verbose
+       flag and sampling rates) in a single state transition, so statements never
+       observe a partially applied configuration. Settings absent from the
+       configuration are left unchanged (see Configuration).
+
+       @param configuration Configuration to apply
+    */
+    static void configure(const Configuration &configuration);
+
+    /**
+       Reloads the configuration file (see Configuration) whenever it changes, or
+       on SIGHUP if requested, from a background thread (see ConfigWatcher).
+       Changes take effect within milliseconds, without locking the logging path.
+       Watching stops on unwatchConfiguration() or terminate().
+
+       @param path Configuration file path
+       @param hangup Reload on SIGHUP
+
+       @return @em false if the file could not be loaded now (it is watched anyway)
+    */
+    static bool watchConfiguration(const std::string &path, bool hangup = true);
+
+    /**
+       Stops watching the configuration file
+    */
+    static void unwatchConfiguration();
+
+    /**
+       Sampling check of statement gates (see setSampling)
+
+       @param level Level of the statement
+
+       @return @em false when the statement must be skipped
+    */
+    static bool isSampled(const Level level) {
+        if (ERT_LIKELY(!(state_.word.load(std::memory_order_relaxed) & SamplingFlag))) return true;
+        std::uint64_t threshold = sampling_[level & 7].load(std::memory_order_relaxed);
+        if (threshold > 0xffffffff) return true;
+        if (nextRandom() < threshold) return true;
+        stats::sampled(level);
+        return false;
+    }
+    static bool isSampled(int level) {
+        return isSampled((Level)level);
+    }
+
+    /**
+       One-in-n check of *_SAMPLED statements: the first execution is admitted and
+       the next n - 1 skipped (and counted), and so on
+
+       @param level Level of the statement
+       @param skip Executions still to skip (per thread and statement)
+       @param n Sampling period
+
+       @return @em false when the statement must be skipped
+    */
+    static bool isSampled(const Level level, std::uint32_t &skip, std::uint32_t n) {
+        if (ERT_LIKELY(skip == 0)) {
+            skip = (n > 0) ? n - 1 : 0;
+            return true;
+        }
+        skip--;
+        stats::sampled(level);
+        return false;
+    }
+    static bool isSampled(int level, std::uint32_t &skip, std::uint32_t n) {
+        return isSampled((Level)level, skip, n);
+    }
+
+    /**
+       Statements within a category block (LOG* macros with category) are checked
+       against the category level instead of the application one. This scope grants
+       the category level to the logging calls made from the block, in the current thread.
+    */
+    class CategoryScope {
+    public:
+        explicit CategoryScope(const Category &category) : previous_(granted_) {
+            granted_ = (int)(category.cache_.load(std::memory_order_relaxed) & LevelMask);
+        }
+        ~CategoryScope() {
+            granted_ = previous_;
+        }
+
+    private:
+        int previous_;
+    };
+
     /**
        Build a string with format and generic arguments
     */
@@ -187,6 +814,166 @@ public:
         log(level, text.c_str(), fromFile, fromLine, fromFunc);
     }
 
+    /**
+       Logs a text formatted with '{}' placeholders when the level is active.
+       The whole record is written once into a reusable thread-local buffer
+       (no heap allocation once warmed up, no length limit) which is passed to
+       the output as is. Argument types are checked at compile time.
+
+       Example: ert::tracing::Logger::logf(ert::tracing::Logger::Debug, ERT_FILE_LOCATION, "x={} y={}", x, y);
+
+       @param level Trace level to register
+       @param fromFile File for trace
+       @param fromLine Line for trace
+       @param fromFunc Function for trace
+       @param format Trace format with '{}' placeholders ('{{' and '}}' for literal braces)
+       @param args Format arguments
+    */
+    template <typename... Args>
+    static void logf(const Level level, const char* fromFile, const int fromLine, const char* fromFunc, const char* format, const Args&... args) {
+        if(!isAllowed(level)) return;
+        LatencyScope latency;
+        const bool output = isOutput(level);
+        std::string &record = buffer();
+        record.clear();
+        if (ERT_LIKELY(!output || getFormat() == Text)) {
+            if (output) appendPrefix(record, level, fromFile, fromLine, fromFunc);
+            std::size_t prefixSize = record.size();
+            format::append(record, format, args...);
+            if (ERT_UNLIKELY(isRecorded(level))) FlightRecorder::record(level, fromFile, fromLine, fromFunc, record.data() + prefixSize, record.size() - prefixSize);
+        }
+        else {
+            std::string &text = scratch();
+            text.clear();
+            format::append(text, format, args...);
+            if (ERT_UNLIKELY(isRecorded(level))) FlightRecorder::record(level, fromFile, fromLine, fromFunc, text.data(), text.size());
+            appendStructured(record, getFormat(), level, fromFile, fromLine, fromFunc, text.data(), text.size());
+            if (getFormat() == Json) record.push_back('}');
+        }
+        if (output) dispatch(level, record, fromFile, fromLine, fromFunc);
+    }
+
+    /**
+       Logs a text for a static call site (see ERT_LOG macro).
+       The pre-rendered site prefix is copied as is, so only the text is processed.
+
+       @param site Call site metadata
+       @param text Trace text
+    */
+    static void log(const CallSite &site, const char* text);
+    static void log(const CallSite &site, const std::string& text) {
+        log(site, text.c_str());
+    }
+
+    /**
+       Logs a text formatted with '{}' placeholders for a static call site (see ERT_LOGF macro).
+
+       @param site Call site metadata
+       @param format Trace format with '{}' placeholders ('{{' and '}}' for literal braces)
+       @param args Format arguments
+    */
+    template <typename... Args>
+    static void logf(const CallSite &site, const char* format, const Args&... args) {
+        const Level level = (Level)site.level;
+        if(!isAllowed(level)) return;
+        LatencyScope latency;
+        if (ERT_UNLIKELY(isRecorded(level))) FlightRecorder::record(site, format, args...);
+        if (!isOutput(level)) return;
+        if (ERT_UNLIKELY(state_.word.load(std::memory_order_relaxed) & BinaryFlag)) {
+            BinaryLog::write(site, format, args...);
+            return;
+        }
+        std::string &record = buffer();
+        const Format style = getFormat();
+        if (ERT_LIKELY(style == Text)) {
+            record.assign(site.prefix, site.prefixSize);
+            format::append(record, format, args...);
+        }
+        else {
+            std::string &text = scratch();
+            text.clear();
+            format::append(text, format, args...);
+            record.clear();
+            appendStructured(record, style, level, site.file, site.line, site.function, text.data(), text.size());
+            if (style == Json) record.push_back('}');
+        }
+        dispatch(level, record, site.file, site.line, site.function);
+    }
+
+    /**
+       Logs a structured record: a message and key/value fields, rendered in the
+       configured format (see setFormat). Field names are copied as they are and
+       values are escaped word-at-a-time, into the reusable record buffer.
+
+       Example: ert::tracing::Logger::log(ert::tracing::Logger::Informational, ERT_FILE_LOCATION, "request served", kv("user", id), kv("ms", t));
+
+       @param level Trace level to register
+       @param fromFile File for trace
+       @param fromLine Line for trace
+       @param fromFunc Function for trace
+       @param message Record message
+       @param fields Record fields (see kv)
+    */
+    template <typename... T>
+    static void log(const Level level, const char* fromFile, const int fromLine, const char* fromFunc, const char* message, const Field<T>&... fields) {
+        if(!isAllowed(level)) return;
+        LatencyScope latency;
+        const bool output = isOutput(level);
+        const Format style = output ? getFormat() : Text;
+        std::string &record = buffer();
+        record.clear();
+        std::size_t prefixSize = 0;
+        if (ERT_LIKELY(style == Text)) {
+            if (output) appendPrefix(record, level, fromFile, fromLine, fromFunc);
+            prefixSize = record.size();
+            record.append(message);
+        }
+        else {
+            appendStructured(record, style, level, fromFile, fromLine, fromFunc, message, std::strlen(message));
+        }
+        (structured::appendField(record, style == Json, fields), ...);
+        if (style == Json) record.push_back('}');
+        if (ERT_UNLIKELY(isRecorded(level))) FlightRecorder::record(level, fromFile, fromLine, fromFunc, record.data() + prefixSize, record.size() - prefixSize);
+        if (output) dispatch(level, record, fromFile, fromLine, fromFunc);
+    }
+
+    // Formatted logger shortcuts (see logf). The format must be a literal: built as C++20
+    // or later its placeholders are checked against the arguments at compile time (see
+    // format::Checked); built as C++17 only the ERT_LOGF macros check them. Use logf()
+    // for formats built at run time:
+    template <typename... Args>
+    static void debugf(const char* fromFile, const int fromLine, const char* fromFunc, format::checked<Args...> format, const Args&... args) {
+        logf(Logger::Debug, fromFile, fromLine, fromFunc, format.text, args...);
+    }
+    template <typename... Args>
+    static void informationalf(const char* fromFile, const int fromLine, const char* fromFunc, format::checked<Args...> format, const Args&... args) {
+        logf(Logger::Informational, fromFile, fromLine, fromFunc, format.text, args...);
+    }
+    template <typename... Args>
+    static void noticef(const char* fromFile, const int fromLine, const char* fromFunc, format::checked<Args...> format, const Args&... args) {
+        logf(Logger::Notice, fromFile, fromLine, fromFunc, format.text, args...);
+    }
+    template <typename... Args>
+    static void warningf(const char* fromFile, const int fromLine, const char* fromFunc, format::checked<Args...> format, const Args&... args) {
+        logf(Logger::Warning, fromFile, fromLine, fromFunc, format.text, args...);
+    }
+    template <typename... Args>
+    static void errorf(const char* fromFile, const int fromLine, const char* fromFunc, format::checked<Args...> format, const Args&... args) {
+        logf(Logger::Error, fromFile, fromLine, fromFunc, format.text, args...);
+    }
+    template <typename... Args>
+    static void criticalf(const char* fromFile, const int fromLine, const char* fromFunc, format::checked<Args...> format, const Args&... args) {
+        logf(Logger::Critical, fromFile, fromLine, fromFunc, format.text, args...);
+    }
+    template <typename... Args>
+    static void alertf(const char* fromFile, const int fromLine, const char* fromFunc, format::checked<Args...> format, const Args&... args) {
+        logf(Logger::Alert, fromFile, fromLine, fromFunc, format.text, args...);
+    }
+    template <typename... Args>
+    static void emergencyf(const char* fromFile, const int fromLine, const char* fromFunc, format::checked<Args...> format, const Args&... args) {
+        logf(Logger::Emergency, fromFile, fromLine, fromFunc, format.text, args...);
+    }
+
     // Specific logger shortcuts:
     /**
        Logger shortcut for debug enabled level
@@ -305,10 +1092,181 @@ public:
     static Level stringAsLevel(const std::string& level);
 
 private:
-    static std::mutex mutex_;
-    static Level level_;
-    static bool initialized_;
-    static bool verbose_;
+    static std::mutex mutex_; // serializes configuration changes
+
+    // Level (low byte), flags (second byte), flight recorder level (bits 12-15), sampling
+    // flag (bit 16) and levels generation (from bit 24), read without locking on every
+    // log statement. Kept alone in its cache line so hot-path loads do
+    // not suffer false sharing:
+    static constexpr std::uint64_t LevelMask = 0xff;
+    static constexpr std::uint64_t VerboseFlag = 0x100;
+    static constexpr std::uint64_t BinaryFlag = 0x200;
+    static constexpr std::uint64_t RateLimitFlag = 0x400;
+    static constexpr std::uint64_t LatencyFlag = 0x800;
+    static constexpr int RecorderShift = 12; // flight recorder level + 1 (0: disabled)
+    static constexpr std::uint64_t RecorderMask = 0xf;
+    static constexpr std::uint64_t SamplingFlag = 0x10000;
+    static constexpr int GenerationShift = 24;
+    static constexpr std::uint64_t GenerationUnit = (std::uint64_t)1 << GenerationShift;
+    struct alignas(64) State {
+        std::atomic<std::uint64_t> word;
+    };
+    static State state_;
+
+    // Category levels:
+    static std::map<std::string, Level> categories_;
+    static std::uint64_t refresh(Category &category);
+    static RateLimiter rate_limiter_;
+    static void reportSuppressed(const Level level, const char* fromFile, const int fromLine, const char* fromFunc, std::uint64_t suppressed);
+    // Reports call sites gone quiet every RateLimitOptions::flushInterval (stopped at exit if still running):
+    struct SuppressedFlusher {
+        std::mutex control; // serializes start() and stop()
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::chrono::milliseconds interval{0}; // 0: stopped
+        void start(std::chrono::milliseconds period);
+        void stop();
+        void join(); // control must be locked
+        ~SuppressedFlusher() { stop(); }
+    };
+    static SuppressedFlusher suppressed_flusher_;
+
+    static thread_local int granted_; // level granted by current CategoryScope (-1: none)
+
+    // Sampling: keep thresholds over 2^32 per level (greater than 2^32 - 1: no sampling)
+    static std::atomic<std::uint64_t> sampling_[8];
+    static thread_local std::uint64_t random_state_;
+    static std::uint64_t seed();
+    static std::uint32_t nextRandom() {
+        // xorshift64*
+        std::uint64_t x = random_state_;
+        if (ERT_UNLIKELY(x == 0)) x = seed();
+        x ^= x >> 12;
+        x ^= x << 25;
+        x ^= x >> 27;
+        random_state_ = x;
+        return (std::uint32_t)((x * 0x2545F4914F6CDD1DULL) >> 32);
+    }
+
+    static bool isAllowed(const Level level) {
+        return (isCaptured(level) || (isCompiled(level) && (int)level <= granted_));
+    }
+
+    // Allowed records go to the output and/or to the flight recorder:
+    static bool isOutput(const Level level) {
+        return ((std::uint32_t)level <= (state_.word.load(std::memory_order_relaxed) & LevelMask) || (int)level <= granted_);
+    }
+    static bool isRecorded(const Level level) {
+        return ((std::uint32_t)level < ((state_.word.load(std::memory_order_relaxed) >> RecorderShift) & RecorderMask));
+    }
+
+    static std::atomic<bool> initialized_;
+    static std::atomic<bool> dump_on_terminate_; // flight recorder
+
+    // Measures the time spent in a log call, from its construction (once the level is accepted):
+    class LatencyScope {
+        std::chrono::steady_clock::time_point start_;
+        bool enabled_;
+
+    public:
+        LatencyScope() : enabled_(state_.word.load(std::memory_order_relaxed) & LatencyFlag) {
+            if (ERT_UNLIKELY(enabled_)) start_ = std::chrono::steady_clock::now();
+        }
+        ~LatencyScope() {
+            if (ERT_UNLIKELY(enabled_)) stats::latency(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count());
+        }
+    };
+
+    // Asynchronous mode:
+    static std::atomic<RecordQueue*> queue_;
+    static std::unique_ptr<RecordQueue> queue_storage_;
+    static std::thread drainer_;
+    static std::atomic<bool> draining_;
+    static std::atomic<bool> drainer_sleeping_;
+    static std::atomic<int> producers_; // producers between loading queue_ and their last queue access
+    static std::atomic<std::uint64_t> async_drops_;
+    static AsyncOptions::Overflow overflow_;
+    static std::chrono::milliseconds overflow_timeout_;
+    static int overflow_level_;
+    static std::atomic<std::uint64_t> overflow_drops_[8]; // drops not reported yet, by level
+    static bool overflow(RecordQueue &queue, const Level level, const std::string &record, std::uint64_t time);
+    static void discard(const Level level);
+    static void reportOverflow();
+    static std::mutex drainer_mutex_;
+    static std::condition_variable drainer_cv_;
+    static std::chrono::milliseconds drainer_idle_wait_;
+    static thread_local bool drainer_thread_;
+
+    static void drain();
+    static void flushSink();
+
+    // Writers delivering records announce themselves in the counter of the current phase;
+    // a configuration change flips the phase twice, waiting for the readers of the previous
+    // one each time, so no reader can still use what it replaced (new readers are not waited
+    // for, so changes are not starved by continuous logging):
+    struct SinkReaders {
+        std::atomic<unsigned int> phase{0};
+        std::atomic<int> count[2] = {};
+        static thread_local int depth; // reading in the calling thread (a sink logging)
+
+        unsigned int enter() {
+            depth++;
+            unsigned int current = phase.load(std::memory_order_seq_cst) & 1;
+            count[current].fetch_add(1, std::memory_order_seq_cst);
+            return current;
+        }
+        void leave(unsigned int current) {
+            count[current].fetch_sub(1, std::memory_order_release);
+            depth--;
+        }
+        bool synchronize(); // false when called by a reader (nothing waited)
+    };
+    class SinkReader {
+    public:
+        SinkReader() : phase_(sink_readers_.enter()) {}
+        ~SinkReader() {
+            sink_readers_.leave(phase_);
+        }
+    private:
+        unsigned int phase_;
+    };
+    static SinkReaders sink_readers_;
+    static std::vector<std::shared_ptr<const void>> sinks_retired_; // freed once no reader uses them
+    static void retire(std::shared_ptr<const void> retired); // mutex_ must be locked
+
+    // Registered sinks, including the main output ("syslog") and the verbose one ("console"):
+    // immutable snapshots replaced on changes (retired ones are freed once no writer delivers
+    // through them):
+    struct SinkEntry {
+        std::string name;
+        std::shared_ptr<Sink> sink;
+        int level;
+        std::shared_ptr<SinkWorker> worker; // nullptr: synchronous delivery
+    };
+    struct SinkSet {
+        std::vector<SinkEntry> entries;
+    };
+    static std::atomic<const SinkSet*> sink_set_; // nullptr: default sinks (syslog and console)
+    static const SinkSet &defaultSinks();
+    static const SinkSet &sinks(); // current set (SinkReader guard needed)
+    static void publishSinks(std::vector<SinkEntry> entries); // mutex_ must be locked
+    static void deliver(const SinkSet &set, const Record &record);
+
+    // Verbose output (configured through verbose(options)):
+    static ConsoleSink &console();
+    static void write(const Level level, const char* line, std::size_t size, std::uint64_t time);
+
+    // Record composition:
+    static std::string &buffer(); // thread-local record buffer
+    static std::string &scratch(); // thread-local message buffer (structured formats)
+    static std::atomic<int> format_;
+    // Structured record up to the message (included), without closing brace.
+    // Both omit the source location when fromFile is null (library generated records):
+    static void appendStructured(std::string &record, const Format style, const Level level, const char* fromFile, const int fromLine, const char* fromFunc, const char *message, std::size_t size);
+    static void appendPrefix(std::string &record, const Level level, const char* fromFile, const int fromLine, const char* fromFunc);
+    static void dispatch(const Level level, const std::string &record, const char* fromFile, const int fromLine, const char* fromFunc);
+    static void route(const Level level, const std::string &record);
 
     Logger() {};
     ~Logger() {};
@@ -0,0 +1,97 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ert/tracing/Sink.hpp>
+
+namespace ert {
+namespace tracing {
+
+/**
+   Sink keeping the last records in memory, mainly to check log output in unit tests:
+
+   auto memory = std::make_shared<ert::tracing::MemorySink>();
+   ert::tracing::Logger::addSink("memory", memory);
+   ...
+   EXPECT_TRUE(memory->contains("connection refused"));
+*/
+class MemorySink : public Sink {
+public:
+    /**
+       @param capacity Number of records kept (the oldest ones are discarded)
+    */
+    explicit MemorySink(std::size_t capacity = 1024) : capacity_(capacity ? capacity : 1) {}
+
+    void write(const Record &record) override;
+
+    /**
+       @return Records kept, oldest first, as level and text pairs
+    */
+    std::vector<std::pair<int, std::string>> records() const;
+
+    /**
+       @param text Text searched
+
+       @return @em true if any record kept contains the text
+    */
+    bool contains(const std::string &text) const;
+
+    /**
+       @return Number of records written since creation or last clear()
+    */
+    std::uint64_t count() const;
+
+    /**
+       Discards the records kept
+    */
+    void clear();
+
+private:
+    std::size_t capacity_;
+    mutable std::mutex mutex_;
+    std::deque<std::pair<int, std::string>> records_;
+    std::uint64_t count_ = 0;
+};
+
+}
+}
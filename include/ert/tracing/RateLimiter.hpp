@@ -0,0 +1,147 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace ert {
+namespace tracing {
+
+/**
+   Rate limiting configuration (see Logger::setRateLimit)
+*/
+struct RateLimitOptions {
+    double rate = 100; // records per second allowed per call site (0: unlimited)
+    unsigned int burst = 200; // records allowed at once per call site
+    bool suppressDuplicates = true; // suppress identical consecutive records of a call site
+    std::chrono::milliseconds duplicateWindow{1000}; // duplicates are emitted again after this time
+    std::chrono::milliseconds flushInterval{1000}; // period to report call sites gone quiet (0: only when they emit again)
+};
+
+/**
+   Per-call-site token bucket and duplicate suppression.
+
+   Call sites are identified by source file pointer and line, so any statement is
+   covered (LOG* macros, shortcuts like error(), and call-site macros). State lives in
+   a fixed open-addressing table of atomics: no lock on the check. The token bucket is
+   implemented as a generic cell rate algorithm over one atomic (theoretical arrival time).
+*/
+class RateLimiter {
+public:
+    static constexpr std::size_t Slots = 1024;
+
+    RateLimiter() {}
+
+    /**
+       Sets the configuration. Counters are kept.
+    */
+    void configure(const RateLimitOptions &options);
+
+    /**
+       Checks whether a record may be emitted
+
+       @param level Record level
+       @param file Source file (its pointer identifies the call site with the line)
+       @param line Source line
+       @param function Source function
+       @param text Record text (used to detect duplicates)
+       @param size Record text size
+       @param suppressed Number of records suppressed before this one, which should be reported (output)
+
+       @return @em false when the record must be suppressed
+    */
+    bool admit(int level, const char *file, int line, const char *function, const char *text, std::size_t size, std::uint64_t &suppressed);
+
+    /**
+       Collects pending suppression counters (resetting them), calling
+       consumer(int level, const char *file, int line, const char *function, std::uint64_t suppressed)
+
+       @param consumer Summary consumer
+       @param expired Only call sites whose window expired (the next record would be admitted)
+    */
+    template <typename Consumer>
+    void collect(Consumer &&consumer, bool expired = false) {
+        const std::int64_t time = expired ? now() : 0;
+        for (std::size_t k = 0; k < Slots; k++) {
+            Slot &slot = slots_[k];
+            if (!slot.key.load(std::memory_order_acquire)) continue;
+            if (!slot.suppressed.load(std::memory_order_relaxed)) continue;
+            const char *function = slot.function.load(std::memory_order_acquire);
+            if (!function) continue;
+            if (expired && !isExpired(slot, time)) continue;
+            std::uint64_t suppressed = slot.suppressed.exchange(0, std::memory_order_acq_rel);
+            if (suppressed) consumer(slot.level.load(std::memory_order_relaxed), slot.file.load(std::memory_order_relaxed), slot.line.load(std::memory_order_relaxed), function, suppressed);
+        }
+    }
+
+    /**
+       @return Total number of suppressed records
+    */
+    std::uint64_t total() const {
+        return total_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> key{0}; // call-site hash (0: free)
+        std::atomic<std::int64_t> tat{0}; // theoretical arrival time (ns)
+        std::atomic<std::uint64_t> last_hash{0}; // last emitted text hash
+        std::atomic<std::int64_t> last_time{0}; // last emitted time (ns)
+        std::atomic<std::uint64_t> suppressed{0};
+        // Call-site information for summaries:
+        std::atomic<int> level{0};
+        std::atomic<int> line{0};
+        std::atomic<const char*> file{nullptr};
+        std::atomic<const char*> function{nullptr};
+    };
+
+    Slot slots_[Slots];
+    std::atomic<std::int64_t> interval_{0}; // ns between records (0: unlimited)
+    std::atomic<std::int64_t> tolerance_{0}; // burst tolerance (ns)
+    std::atomic<std::int64_t> duplicate_window_{0}; // ns (0: duplicates allowed)
+    std::atomic<std::uint64_t> total_{0};
+
+    Slot *find(int level, const char *file, int line, const char *function);
+    bool isExpired(const Slot &slot, std::int64_t time) const;
+    static std::int64_t now(); // ns
+};
+
+}
+}
+
@@ -0,0 +1,192 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace ert {
+namespace tracing {
+
+/**
+   Bounded lock-free queue of log records (Vyukov's sequence-numbered ring).
+
+   Multiple producers (application threads) push already formatted records and
+   the logger drain thread pops them; producers may also pop the oldest record to
+   make room (drop oldest overflow policy). Record texts are
+   stored in per-slot strings which keep their capacity, so once warmed up
+   no heap allocation happens on the producer side.
+*/
+class RecordQueue {
+public:
+    /**
+       Constructor
+
+       @param capacity Number of records (rounded up to the next power of two)
+       @param recordSize Bytes reserved in advance for every record text
+    */
+    RecordQueue(std::size_t capacity, std::size_t recordSize);
+
+    /**
+       Appends a record. Never blocks.
+
+       @param level Record level
+       @param text Record text
+       @param size Record text size
+       @param time Record Clock stamp
+
+       @return @em false when the queue is full
+    */
+    bool push(int level, const char *text, std::size_t size, std::uint64_t time) {
+        Slot *slot;
+        std::size_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            slot = &slots_[pos & mask_];
+            std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+            std::intptr_t diff = (std::intptr_t)seq - (std::intptr_t)pos;
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            }
+            else if (diff < 0) {
+                return false;
+            }
+            else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->level = level;
+        slot->time = time;
+        slot->text.assign(text, size);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+       Extracts the oldest record, if any, passing it to the consumer
+       as (int level, const std::string &text, std::uint64_t time) before releasing the slot.
+
+       @return @em false when the queue is empty
+    */
+    template <typename Consumer>
+    bool pop(Consumer &&consumer) {
+        std::size_t pos;
+        Slot *slot = claim(pos);
+        if (!slot) return false;
+
+        consumer(slot->level, (const std::string &)slot->text, slot->time);
+        slot->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+       Extracts the oldest record, if any, releasing its slot at once: the text is swapped
+       with the given buffer, whose storage is left to the slot for the next push. Meant for
+       slow consumers, which would otherwise keep the slot (and the queue full) while they work.
+
+       @param level Record level
+       @param text Buffer receiving the record text
+       @param time Record Clock stamp
+
+       @return @em false when the queue is empty
+    */
+    bool take(int &level, std::string &text, std::uint64_t &time) {
+        std::size_t pos;
+        Slot *slot = claim(pos);
+        if (!slot) return false;
+
+        level = slot->level;
+        time = slot->time;
+        text.swap(slot->text);
+        slot->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+       @return Approximated number of queued records
+    */
+    std::size_t size() const {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        return (tail > head) ? (tail - head) : 0;
+    }
+
+    /**
+       @return Queue capacity (number of records)
+    */
+    std::size_t capacity() const {
+        return mask_ + 1;
+    }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<std::size_t> sequence;
+        int level;
+        std::uint64_t time;
+        std::string text;
+    };
+
+    // Claims the oldest record slot (nullptr when the queue is empty):
+    Slot *claim(std::size_t &pos) {
+        pos = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot *slot = &slots_[pos & mask_];
+            std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+            std::intptr_t diff = (std::intptr_t)seq - (std::intptr_t)(pos + 1);
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) return slot;
+            }
+            else if (diff < 0) {
+                return nullptr;
+            }
+            else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::unique_ptr<Slot[]> slots_;
+    std::size_t mask_;
+    alignas(64) std::atomic<std::size_t> tail_;
+    alignas(64) std::atomic<std::size_t> head_;
+};
+
+}
+}
+
@@ -0,0 +1,232 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <ert/tracing/Sink.hpp>
+
+namespace ert {
+namespace tracing {
+
+/**
+   Shared memory ring configuration
+*/
+struct SharedRingOptions {
+    std::string name = "/ert-logger"; // POSIX shared memory object name (see shm_open)
+    std::size_t slots = 16384; // number of records (rounded up to a power of two)
+    std::size_t slotSize = 512; // bytes per record slot, including a 40 bytes header
+    std::chrono::milliseconds stallTimeout{1000}; // collector: time to abandon a slot reserved but never written
+};
+
+/**
+   Bounded lock-free ring of log records in POSIX shared memory, shared by the
+   processes of a deployment (for example pre-forked workers) and drained by a
+   single collector (see SharedRingCollector).
+
+   Writers reserve a slot with a compare-and-swap on the shared tail and publish it
+   with a compare-and-swap on the slot sequence, so no lock is ever held across
+   processes. A writer dying between reservation and publication leaves its slot
+   unpublished: the collector abandons it after the stall timeout (a lost record,
+   counted as a drop). Every slot carries its position and a checksum, so a stalled
+   writer resuming late cannot corrupt the records delivered (torn slots are discarded
+   and counted). Records are delivered with the process id of their writer.
+
+   The first process opening the ring creates and initializes it; the others wait
+   for the initialization and check the layout is the same.
+*/
+class SharedRing {
+public:
+    explicit SharedRing(const SharedRingOptions &options);
+    ~SharedRing();
+
+    SharedRing(const SharedRing&) = delete;
+    SharedRing& operator=(const SharedRing&) = delete;
+
+    /**
+       @return @em false if the shared memory could not be created, mapped or has a different layout
+    */
+    bool isOpen() const {
+        return (header_ != nullptr);
+    }
+
+    /**
+       Appends a record (texts longer than the slot are truncated). Never blocks.
+       The Clock stamp is stored converted into nanoseconds since epoch, so it
+       means the same in the collector process.
+
+       @return @em false when the ring is full (record dropped and counted)
+    */
+    bool push(int level, const char *text, std::size_t size, std::uint64_t time = 0);
+
+    /**
+       Delivers pending records, oldest first, to the consumer. Only one process
+       or thread may drain the ring at a time.
+
+       @param consumer Record consumer
+       @param max Maximum number of records delivered
+
+       @return Number of records delivered
+    */
+    std::size_t drain(const std::function<void(const Record&)> &consumer, std::size_t max);
+
+    /**
+       @return Number of records lost because the ring was full, or because their
+       writer stalled (or died) and the collector abandoned the slot
+    */
+    std::uint64_t drops() const;
+
+    /**
+       @return Number of slots discarded by the collector because they were torn
+    */
+    std::uint64_t discarded() const;
+
+    /**
+       Removes the shared memory object name (mappings remain valid)
+
+       @param name Shared memory object name
+    */
+    static void unlink(const std::string &name);
+
+private:
+    struct Header;
+    struct Slot;
+
+    SharedRingOptions options_;
+    Header *header_;
+    char *slots_;
+    std::size_t mapped_;
+    std::size_t mask_;
+    std::size_t slot_size_;
+
+    // Collector stall tracking:
+    std::uint64_t stalled_position_;
+    std::chrono::steady_clock::time_point stalled_since_;
+
+    Slot *slot(std::uint64_t position) const;
+};
+
+/**
+   Sink appending records to a shared memory ring, for processes whose output is
+   written by a collector:
+
+   ert::tracing::Logger::setSink(std::make_shared<ert::tracing::SharedRingSink>(ert::tracing::SharedRingOptions{}));
+*/
+class SharedRingSink : public Sink {
+public:
+    explicit SharedRingSink(const SharedRingOptions &options) : ring_(options) {}
+
+    void write(const Record &record) override {
+        ring_.push(record.level, record.text, record.size, record.time);
+    }
+
+    /**
+       @return Shared memory ring
+    */
+    SharedRing &ring() {
+        return ring_;
+    }
+
+private:
+    SharedRing ring_;
+};
+
+/**
+   Collector thread draining a shared memory ring into a sink in batches (the sink
+   is flushed once per batch). It may run in a supervisor process, or standalone
+   with the ert_logger_collector tool.
+*/
+class SharedRingCollector {
+public:
+    /**
+       Constructor
+
+       @param options Shared memory ring configuration
+       @param output Output sink (for example DatagramSink or FileSink, which render the writer process id)
+       @param batch Maximum records per batch
+       @param idleWait Sleep when the ring is empty
+    */
+    SharedRingCollector(const SharedRingOptions &options, std::shared_ptr<Sink> output, std::size_t batch = 1024, std::chrono::milliseconds idleWait = std::chrono::milliseconds(5));
+
+    ~SharedRingCollector();
+
+    SharedRingCollector(const SharedRingCollector&) = delete;
+    SharedRingCollector& operator=(const SharedRingCollector&) = delete;
+
+    /**
+       Stops the thread once the pending records are delivered (also done on destruction)
+    */
+    void stop();
+
+    /**
+       @return Shared memory ring
+    */
+    SharedRing &ring() {
+        return ring_;
+    }
+
+    /**
+       @return Number of records delivered
+    */
+    std::uint64_t delivered() const {
+        return delivered_.load(std::memory_order_relaxed);
+    }
+
+private:
+    SharedRing ring_;
+    std::shared_ptr<Sink> output_;
+    std::size_t batch_;
+    std::chrono::milliseconds idle_wait_;
+    std::atomic<std::uint64_t> delivered_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_;
+    std::thread thread_;
+
+    void run();
+};
+
+}
+}
@@ -0,0 +1,92 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ert {
+namespace tracing {
+
+/**
+   Log record as delivered to sinks: the text is the complete
+   '[Level]|file:line(func)|text' line, formatted once.
+*/
+struct Record {
+    int level; // syslog priority (Logger::Level)
+    const char *text; // not null-terminated necessarily
+    std::size_t size;
+    std::uint64_t time = 0; // Clock stamp when logged (0: not stamped, sinks take the current time)
+    int pid = 0; // writer process id, for records collected from other processes (0: this process)
+};
+
+/**
+   Log output interface. Replaces the glibc syslog() output when set with Logger::setSink().
+
+   Sinks may buffer records in write() until flush() is called: in synchronous mode
+   the logger flushes after every record; in asynchronous mode the drain thread
+   flushes when there are no more pending records, so records are batched.
+   Implementations must be thread-safe.
+*/
+class Sink {
+public:
+    virtual ~Sink() {}
+
+    /**
+       Writes (or buffers) a record
+
+       @param record Log record
+    */
+    virtual void write(const Record &record) = 0;
+
+    /**
+       Delivers buffered records, if any
+    */
+    virtual void flush() {}
+};
+
+/**
+   Options of sinks registered with Logger::addSink()
+*/
+struct SinkOptions {
+    int level = 7; // most verbose level delivered (Logger::Level, Debug by default)
+    bool worker = false; // deliver from a dedicated thread, so a slow sink does not stall the others
+    std::size_t queueSize = 8192; // worker queue capacity in records (overflow records are dropped)
+};
+
+}
+}
+
@@ -0,0 +1,119 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <ert/tracing/Sink.hpp>
+
+namespace ert {
+namespace tracing {
+
+/**
+   Dedicated delivery thread of a registered sink (SinkOptions::worker).
+
+   Records are queued as shared references to the line formatted once by the
+   logger, so every worker sink receives the same buffer without copies. When the
+   queue is full records are dropped instead of blocking the producer: a slow sink
+   never stalls the application nor the other sinks.
+*/
+class SinkWorker {
+public:
+    SinkWorker(std::shared_ptr<Sink> sink, std::size_t capacity);
+    ~SinkWorker();
+
+    SinkWorker(const SinkWorker&) = delete;
+    SinkWorker& operator=(const SinkWorker&) = delete;
+
+    /**
+       Queues a record
+
+       @param level Record level
+       @param line Formatted record
+       @param time Record Clock stamp
+
+       @return @em false if the record was dropped (queue full or worker stopped)
+    */
+    bool post(int level, const std::shared_ptr<const std::string> &line, std::uint64_t time);
+
+    /**
+       Delivers pending records, flushes the sink and stops the thread
+    */
+    void stop();
+
+    /**
+       @return Number of records dropped
+    */
+    std::uint64_t drops() const {
+        return drops_.load(std::memory_order_relaxed);
+    }
+
+    /**
+       @return Queue capacity in records
+    */
+    std::size_t capacity() const {
+        return capacity_;
+    }
+
+private:
+    struct Entry {
+        int level;
+        std::uint64_t time;
+        std::shared_ptr<const std::string> line;
+    };
+
+    std::shared_ptr<Sink> sink_;
+    std::size_t capacity_;
+    std::atomic<std::uint64_t> drops_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Entry> pending_;
+    bool stopping_;
+    std::thread thread_;
+
+    void run();
+};
+
+}
+}
@@ -0,0 +1,140 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ert {
+namespace tracing {
+
+/**
+   Log-linear (HDR style) latency histogram in nanoseconds: every power of two
+   is split into 2^SubBits buckets, so bucket width is within 12.5% of its values.
+   Values from 2^MaxExponent ns (about 18 minutes) on are counted in the last bucket.
+*/
+struct LatencyHistogram {
+    static constexpr int SubBits = 3;
+    static constexpr int SubBuckets = 1 << SubBits;
+    static constexpr int MaxExponent = 40;
+    static constexpr std::size_t Buckets = (MaxExponent - SubBits + 1) * SubBuckets;
+
+    std::array<std::uint64_t, Buckets> counts{};
+    std::uint64_t count = 0;
+    std::uint64_t sum = 0; // ns
+
+    /**
+       @return Bucket index for a value
+    */
+    static std::size_t bucket(std::uint64_t ns) {
+        if (ns < SubBuckets) return ns;
+        int exponent = 63 - __builtin_clzll(ns);
+        if (exponent >= MaxExponent) return Buckets - 1;
+        return (exponent - SubBits + 1) * SubBuckets + ((ns >> (exponent - SubBits)) & (SubBuckets - 1));
+    }
+
+    /**
+       @return Least value counted in a bucket
+    */
+    static std::uint64_t lowerBound(std::size_t bucket) {
+        if (bucket < SubBuckets) return bucket;
+        int exponent = (int)(bucket / SubBuckets) + SubBits - 1;
+        return (std::uint64_t)(SubBuckets + bucket % SubBuckets) << (exponent - SubBits);
+    }
+
+    /**
+       @return Least value greater than every value counted in a bucket
+    */
+    static std::uint64_t upperBound(std::size_t bucket) {
+        return lowerBound(bucket + 1);
+    }
+
+    /**
+       @param quantile Quantile in [0, 1]
+
+       @return Upper bound of the bucket holding the quantile (0 when empty)
+    */
+    std::uint64_t percentile(double quantile) const;
+};
+
+/**
+   Counters of a log level
+*/
+struct LevelStats {
+    std::uint64_t emitted = 0; // records written or queued
+    std::uint64_t bytes = 0; // text bytes of emitted records
+    std::uint64_t drops = 0; // records dropped (asynchronous queue full)
+    std::uint64_t suppressed = 0; // records suppressed by rate limiting
+    std::uint64_t sampled = 0; // statements skipped by sampling
+};
+
+/**
+   Logger metrics snapshot (see Logger::stats)
+*/
+struct Stats {
+    std::array<LevelStats, 8> levels; // indexed by level (Logger::Level)
+    LatencyHistogram latency; // time spent in log calls (when measured)
+
+    /**
+       Renders the snapshot in Prometheus text exposition format
+
+       @param prefix Metric names prefix
+
+       @return Metrics text
+    */
+    std::string prometheus(const std::string &prefix = "ert_logger") const;
+};
+
+namespace stats {
+
+// Recording side, per thread shard (no contention, no false sharing):
+void emitted(int level, std::size_t bytes);
+void dropped(int level);
+void suppressed(int level);
+void sampled(int level);
+void latency(std::uint64_t ns);
+
+/**
+   @return Sum of every thread counters, including finished threads
+*/
+Stats snapshot();
+
+}
+
+}
+}
@@ -0,0 +1,235 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <ert/tracing/Format.hpp>
+
+namespace ert {
+namespace tracing {
+
+/**
+   Structured record field (see kv)
+*/
+template <typename T>
+struct Field {
+    const char *key; // rendered as is (plain identifier expected)
+    std::size_t keySize;
+    const T &value; // valid during the log call
+};
+
+/**
+   Builds a structured record field. The key length is known at compile time, so
+   the name is just copied on rendering.
+
+   Example: ert::tracing::Logger::log(ert::tracing::Logger::Informational, ERT_FILE_LOCATION, "request served", kv("user", id), kv("ms", t));
+
+   @param key Field name (string literal)
+   @param value Field value (same types as format::appendArgument)
+*/
+template <std::size_t N, typename T>
+constexpr Field<T> kv(const char (&key)[N], const T &value) {
+    return Field<T>{key, N - 1, value};
+}
+
+namespace structured {
+
+// Word-at-a-time (SWAR) byte classification over 8 bytes:
+constexpr std::uint64_t Ones = 0x0101010101010101ULL;
+constexpr std::uint64_t Highs = 0x8080808080808080ULL;
+
+inline std::uint64_t load(const char *p) {
+    std::uint64_t result;
+    std::memcpy(&result, p, sizeof(result));
+    return result;
+}
+
+// Non-zero when any byte equals c
+inline std::uint64_t hasByte(std::uint64_t word, unsigned char c) {
+    std::uint64_t x = word ^ (Ones * c);
+    return (x - Ones) & ~x & Highs;
+}
+
+// Non-zero when any byte is a control character (< 0x20)
+inline std::uint64_t hasControl(std::uint64_t word) {
+    return (word - Ones * 0x20) & ~word & Highs;
+}
+
+inline bool mustEscape(unsigned char c) {
+    return (c < 0x20 || c == '"' || c == '\\');
+}
+
+/**
+   Appends text escaped as JSON string contents. Clean runs are scanned
+   eight bytes at a time and copied at once; UTF-8 bytes pass through.
+*/
+inline void appendEscaped(std::string &out, const char *data, std::size_t size) {
+    static const char hex[] = "0123456789abcdef";
+    const char *p = data, *end = data + size, *run = data;
+
+    while (p < end) {
+        if (end - p >= 8) {
+            std::uint64_t word = load(p);
+            if (!(hasByte(word, '"') | hasByte(word, '\\') | hasControl(word))) {
+                p += 8;
+                continue;
+            }
+        }
+
+        unsigned char c = *p;
+        if (!mustEscape(c)) {
+            p++;
+            continue;
+        }
+
+        out.append(run, p - run);
+        switch (c) {
+        case '"': out.append("\\\"", 2); break;
+        case '\\': out.append("\\\\", 2); break;
+        case '\n': out.append("\\n", 2); break;
+        case '\r': out.append("\\r", 2); break;
+        case '\t': out.append("\\t", 2); break;
+        default: {
+            char aux[6] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xf] };
+            out.append(aux, sizeof(aux));
+        }
+        }
+        run = ++p;
+    }
+    out.append(run, p - run);
+}
+
+/**
+   @return @em true when a logfmt value must be quoted (empty, or containing
+   spaces, '=', quotes, backslashes or control characters)
+*/
+inline bool needsQuoting(const char *data, std::size_t size) {
+    if (!size) return true;
+    const char *p = data, *end = data + size;
+    for (; end - p >= 8; p += 8) {
+        std::uint64_t word = load(p);
+        if (hasByte(word, ' ') | hasByte(word, '=') | hasByte(word, '"') | hasByte(word, '\\') | hasControl(word)) return true;
+    }
+    for (; p < end; p++) {
+        if (*p == ' ' || *p == '=' || mustEscape(*p)) return true;
+    }
+    return false;
+}
+
+/**
+   Appends a string value: always quoted in JSON, only when needed in logfmt
+*/
+inline void appendString(std::string &out, bool json, const char *data, std::size_t size) {
+    if (!json && !needsQuoting(data, size)) {
+        out.append(data, size);
+        return;
+    }
+    out.push_back('"');
+    appendEscaped(out, data, size);
+    out.push_back('"');
+}
+
+template <typename T> struct unsupported : std::false_type {};
+
+/**
+   Appends a field value as JSON or logfmt
+
+   @param out Destination buffer
+   @param json JSON (@em true) or logfmt (@em false) rendering
+   @param value Field value
+*/
+template <typename T>
+void appendValue(std::string &out, bool json, const T &value) {
+    using D = std::decay_t<T>;
+
+    if constexpr (std::is_integral_v<D> && !std::is_same_v<D, char>) { // bool included
+        format::appendArgument(out, value);
+    }
+    else if constexpr (std::is_same_v<D, char>) {
+        appendString(out, json, &value, 1);
+    }
+    else if constexpr (std::is_floating_point_v<D>) {
+        if (json && !std::isfinite(value)) out.append("null");
+        else format::appendArgument(out, value);
+    }
+    else if constexpr (std::is_enum_v<D>) {
+        appendValue(out, json, static_cast<std::underlying_type_t<D>>(value));
+    }
+    else if constexpr (std::is_same_v<D, const char*> || std::is_same_v<D, char*>) {
+        const char *str = value;
+        if (!str) out.append(json ? "null":"(null)");
+        else appendString(out, json, str, std::strlen(str));
+    }
+    else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        std::string_view view(value);
+        appendString(out, json, view.data(), view.size());
+    }
+    else if constexpr (std::is_pointer_v<D> || std::is_null_pointer_v<D>) {
+        if (json) out.push_back('"');
+        format::appendArgument(out, value);
+        if (json) out.push_back('"');
+    }
+    else {
+        static_assert(unsupported<T>::value, "ert::tracing::structured: unsupported field type");
+    }
+}
+
+/**
+   Appends a field: ',"key":value' in JSON, ' key=value' in logfmt (and text records)
+*/
+template <typename T>
+void appendField(std::string &out, bool json, const Field<T> &field) {
+    if (json) {
+        out.append(",\"", 2).append(field.key, field.keySize).append("\":", 2);
+    }
+    else {
+        out.push_back(' ');
+        out.append(field.key, field.keySize).push_back('=');
+    }
+    appendValue(out, json, field.value);
+}
+
+}
+
+}
+}
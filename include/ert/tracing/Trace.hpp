@@ -0,0 +1,188 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <ert/tracing/Clock.hpp>
+#include <ert/tracing/Logger.hpp>
+
+// Scoped timing spans (see Trace):
+//
+// void decode(...) {
+//   ERT_TRACE_SPAN("decode"); // Debug level
+//   ...
+//   {
+//     ERT_TRACE_SPAN_LEVEL(ert::tracing::Logger::Informational, "decode.body");
+//     ...
+//   }
+// }
+//
+// ERT_TRACE_SPAN_CATEGORY("http2", "decode"); // Debug level, exported with the category
+//
+// Span names and categories must be string literals (or live until the trace is exported).
+// Spans are gated by the trace level (Trace::isActive), not by the log output level. Spans
+// for levels under ERT_LOGGER_COMPILE_MIN_LEVEL are discarded at compile time.
+#define ERT_TRACE_CONCAT2_(a, b) a##b
+#define ERT_TRACE_CONCAT_(a, b) ERT_TRACE_CONCAT2_(a, b)
+#define ERT_TRACE_SPAN_(level, name, category) ert::tracing::Span ERT_TRACE_CONCAT_(ert_span_, __COUNTER__)( \
+    ert::tracing::Logger::isCompiled(level) && ert::tracing::Trace::isActive(level), name, category)
+#define ERT_TRACE_SPAN_LEVEL(level, name) ERT_TRACE_SPAN_(level, name, nullptr)
+#define ERT_TRACE_SPAN(name) ERT_TRACE_SPAN_(ert::tracing::Logger::Debug, name, nullptr)
+#define ERT_TRACE_SPAN_CATEGORY(category, name) ERT_TRACE_SPAN_(ert::tracing::Logger::Debug, name, category)
+
+namespace ert {
+namespace tracing {
+
+/**
+   Span tracing configuration (see Trace::enable)
+*/
+struct TraceOptions {
+    std::size_t spans = 8192; // spans kept per thread (rounded up to a power of two)
+    int level = 7; // most verbose span level recorded (Logger::Level, Debug by default)
+};
+
+/**
+   Span tracer: every thread keeps its last completed spans (name, start, end and
+   thread id) in a fixed ring, written without lock, allocation or formatting, and
+   the spans of all threads are exported as a Chrome trace-event JSON document
+   (chrome://tracing, https://ui.perfetto.dev) to view per-thread timelines.
+
+   Spans are gated by their own level (TraceOptions::level), so a node logging at
+   Warning can still record Debug spans. Timestamps come from Clock when enabled (TSC),
+   from system_clock otherwise. Rings are sequence-stamped, so an export running
+   concurrently skips spans being overwritten; rings of finished threads are reused
+   by new threads and their spans are kept until then.
+*/
+class Trace {
+public:
+    /**
+       Starts recording spans, or changes the span level (the ring size is fixed by the first call)
+
+       @param options Configuration
+    */
+    static void enable(const TraceOptions &options = TraceOptions());
+
+    /**
+       Stops recording spans (recorded spans are kept for export)
+    */
+    static void disable();
+
+    /**
+       @return @em true when spans are recorded
+    */
+    static bool isEnabled() {
+        return (level_.load(std::memory_order_relaxed) >= 0);
+    }
+
+    /**
+       @param level Span level (Logger::Level)
+
+       @return @em true when spans of this level are recorded
+    */
+    static bool isActive(int level) {
+        return (level <= level_.load(std::memory_order_relaxed));
+    }
+
+    /**
+       @return Current span stamp
+    */
+    static std::uint64_t now() {
+        std::uint64_t stamp = Clock::now();
+        return stamp ? stamp : std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+       Records a completed span on the calling thread ring
+
+       @param name Span name (string literal)
+       @param start Start stamp (see now())
+       @param end End stamp (see now())
+       @param category Span category (string literal, nullptr: 'ert')
+    */
+    static void record(const char *name, std::uint64_t start, std::uint64_t end, const char *category = nullptr);
+
+    /**
+       @return Spans recorded, as a Chrome trace-event JSON document (complete 'X'
+       events in microseconds from the earliest span, thread names as metadata)
+    */
+    static std::string json();
+
+    /**
+       Writes json() into a file
+
+       @param path File path
+
+       @return @em false if the file could not be written
+    */
+    static bool exportJson(const std::string &path);
+
+private:
+    struct Ring;
+
+    static std::atomic<int> level_; // -1: disabled
+    static std::atomic<Ring*> rings_;
+    static std::atomic<std::size_t> capacity_; // 0: never enabled
+
+    static Ring *ring();
+};
+
+/**
+   Scoped span (see ERT_TRACE_SPAN): recorded on destruction if active on construction
+*/
+class Span {
+public:
+    Span(bool active, const char *name, const char *category = nullptr) : name_(active ? name : nullptr), category_(category), start_(active ? Trace::now() : 0) {}
+
+    ~Span() {
+        if (ERT_UNLIKELY(name_ != nullptr)) Trace::record(name_, start_, Trace::now(), category_);
+    }
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+private:
+    const char *name_;
+    const char *category_;
+    std::uint64_t start_;
+};
+
+}
+}
@@ -0,0 +1,188 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <stdio.h>
+
+#include <algorithm>
+
+#include <ert/tracing/BinaryLog.hpp>
+
+
+namespace ert {
+namespace tracing {
+
+namespace {
+
+struct SiteDefinition {
+    std::uint32_t id;
+    std::uint8_t level;
+    std::uint32_t line;
+    std::string file;
+    std::string function;
+    std::string format;
+};
+
+// Lock order: buffers mutex -> thread buffer mutex -> file mutex
+std::mutex file_mutex;
+FILE *file = nullptr;
+std::vector<SiteDefinition> sites;
+
+void writeEntry(binary::Kind kind, const char *body, std::size_t size)
+{
+    if (!file) return;
+    std::uint32_t size32 = size;
+    fputc(kind, file);
+    fwrite(&size32, sizeof(size32), 1, file);
+    fwrite(body, 1, size, file);
+}
+
+// Written before records, which may carry TSC ticks (nothing until the clock is calibrated):
+void writeCalibration()
+{
+    Clock::Calibration calibration = Clock::calibration();
+    if (!calibration.baseNs) return;
+
+    std::vector<char> body;
+    binary::put(body, calibration.baseTicks);
+    binary::put(body, calibration.baseNs);
+    binary::put(body, calibration.nsPerTick);
+    writeEntry(binary::CalibrationEntry, body.data(), body.size());
+}
+
+void writeSite(const SiteDefinition &site)
+{
+    std::vector<char> body;
+    binary::put(body, site.id);
+    binary::put(body, site.level);
+    binary::put(body, site.line);
+    binary::putString(body, site.file.data(), site.file.size());
+    binary::putString(body, site.function.data(), site.function.size());
+    binary::putString(body, site.format.data(), site.format.size());
+    writeEntry(binary::SiteEntry, body.data(), body.size());
+}
+
+}
+
+std::atomic<std::size_t> BinaryLog::buffer_size_(65536);
+std::mutex BinaryLog::buffers_mutex_;
+std::vector<BinaryLog::ThreadBuffer*> BinaryLog::buffers_;
+
+BinaryLog::ThreadBuffer::ThreadBuffer()
+{
+    data.reserve(buffer_size_.load(std::memory_order_relaxed) + 1024);
+    std::lock_guard<std::mutex> guard(buffers_mutex_);
+    buffers_.push_back(this);
+}
+
+BinaryLog::ThreadBuffer::~ThreadBuffer()
+{
+    std::lock_guard<std::mutex> guard(buffers_mutex_);
+    buffers_.erase(std::remove(buffers_.begin(), buffers_.end(), this), buffers_.end());
+    std::lock_guard<std::mutex> buffer_guard(mutex);
+    BinaryLog::flush(*this);
+}
+
+BinaryLog::ThreadBuffer &BinaryLog::threadBuffer()
+{
+    thread_local ThreadBuffer result;
+    return result;
+}
+
+bool BinaryLog::open(const std::string &path, std::size_t bufferSize)
+{
+    flush();
+
+    std::lock_guard<std::mutex> guard(file_mutex);
+    if (file) fclose(file);
+    file = fopen(path.c_str(), "wb");
+    if (!file) return false;
+
+    buffer_size_.store(bufferSize, std::memory_order_relaxed);
+    fwrite(binary::Magic, 1, binary::MagicSize, file);
+    writeCalibration();
+    for (const auto &site : sites) writeSite(site);
+
+    return true;
+}
+
+void BinaryLog::close()
+{
+    flush();
+
+    std::lock_guard<std::mutex> guard(file_mutex);
+    if (file) fclose(file);
+    file = nullptr;
+}
+
+void BinaryLog::flush()
+{
+    std::lock_guard<std::mutex> guard(buffers_mutex_);
+    for (ThreadBuffer *buffer : buffers_) {
+        std::lock_guard<std::mutex> buffer_guard(buffer->mutex);
+        flush(*buffer);
+    }
+
+    std::lock_guard<std::mutex> file_guard(file_mutex);
+    if (file) fflush(file);
+}
+
+void BinaryLog::flush(ThreadBuffer &buffer)
+{
+    if (buffer.data.empty()) return;
+
+    std::lock_guard<std::mutex> guard(file_mutex);
+    writeCalibration();
+    writeEntry(binary::RecordsEntry, buffer.data.data(), buffer.data.size());
+    buffer.data.clear();
+}
+
+std::uint32_t BinaryLog::registerSite(const CallSite &site, const char *format)
+{
+    std::lock_guard<std::mutex> guard(file_mutex);
+
+    std::uint32_t id = site.state->id.load(std::memory_order_acquire);
+    if (id) return id; // registered meanwhile by another thread
+
+    id = sites.size() + 1;
+    sites.push_back(SiteDefinition{id, (std::uint8_t)site.level, (std::uint32_t)site.line, site.file, site.function, format});
+    writeSite(sites.back());
+    site.state->id.store(id, std::memory_order_release);
+
+    return id;
+}
+
+}
+}
+
@@ -0,0 +1,204 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+#include <cmath>
+
+#include <ert/tracing/Clock.hpp>
+
+
+namespace ert {
+namespace tracing {
+
+std::atomic<int> Clock::mode_(Clock::Disabled);
+std::atomic<std::uint32_t> Clock::sequence_(0);
+std::atomic<std::uint64_t> Clock::base_ticks_(0);
+std::atomic<std::int64_t> Clock::base_ns_(0);
+std::atomic<double> Clock::ns_per_tick_(1.0);
+std::uint64_t Clock::origin_ticks_ = 0;
+std::int64_t Clock::origin_ns_ = 0;
+std::mutex Clock::mutex_;
+std::condition_variable Clock::cv_;
+std::thread Clock::calibrator_;
+bool Clock::stopping_ = false;
+
+namespace {
+
+// Stops the calibrator at exit if the application did not (defined after the clock statics, so destroyed before them):
+struct Stopper {
+    ~Stopper() {
+        Clock::disable();
+    }
+} stopper;
+
+}
+
+bool Clock::enable(std::chrono::milliseconds recalibration)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (mode_.load(std::memory_order_relaxed) != Disabled) return isTsc();
+
+    if (!isInvariantTsc()) {
+        mode_.store(System, std::memory_order_relaxed);
+        return false;
+    }
+
+    calibrate(true);
+    mode_.store(Tsc, std::memory_order_relaxed);
+    stopping_ = false;
+    calibrator_ = std::thread(run, recalibration);
+    return true;
+}
+
+void Clock::disable()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    mode_.store(Disabled, std::memory_order_relaxed);
+    if (!calibrator_.joinable()) return;
+
+    stopping_ = true;
+    cv_.notify_one();
+    std::thread calibrator = std::move(calibrator_);
+    lock.unlock();
+    calibrator.join();
+}
+
+Clock::Calibration Clock::calibration()
+{
+    Calibration result;
+    // Bounded retries: a signal handler may interrupt the calibrator in the middle of an update
+    for (int attempt = 0; attempt < 1000; attempt++) {
+        std::uint32_t sequence = sequence_.load(std::memory_order_acquire);
+        result.baseTicks = base_ticks_.load(std::memory_order_acquire);
+        result.baseNs = base_ns_.load(std::memory_order_acquire);
+        result.nsPerTick = ns_per_tick_.load(std::memory_order_acquire);
+        if (!(sequence & 1) && sequence == sequence_.load(std::memory_order_relaxed)) break;
+    }
+    return result;
+}
+
+std::int64_t Clock::toNanoseconds(std::uint64_t stamp)
+{
+    if (!stamp || !(stamp & TscTag)) return toNanoseconds(stamp, Calibration());
+    return toNanoseconds(stamp, calibration());
+}
+
+std::int64_t Clock::toNanoseconds(std::uint64_t stamp, const Calibration &calibration)
+{
+    if (!stamp) return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    if (!(stamp & TscTag)) return (std::int64_t)stamp;
+
+    return calibration.baseNs + (std::int64_t)std::llround((double)(std::int64_t)((stamp & ~TscTag) - calibration.baseTicks) * calibration.nsPerTick);
+}
+
+bool Clock::isInvariantTsc()
+{
+#ifdef ERT_CLOCK_TSC
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) || eax < 0x80000007) return false;
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) return false;
+    return (edx & (1u << 8)); // invariant TSC: constant rate in every P/C-state
+#else
+    return false;
+#endif
+}
+
+void Clock::sample(std::uint64_t &ticks, std::int64_t &ns)
+{
+#ifdef ERT_CLOCK_TSC
+    // Tightest of a few (tsc, system_clock, tsc) readings, ticks at the middle:
+    std::uint64_t best = ~(std::uint64_t)0;
+    for (int k = 0; k < 5; k++) {
+        std::uint64_t before = __rdtsc();
+        std::int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        std::uint64_t after = __rdtsc();
+        if (after - before < best) {
+            best = after - before;
+            ticks = before + best / 2;
+            ns = now;
+        }
+    }
+#else
+    ticks = 0;
+    ns = 0;
+#endif
+}
+
+void Clock::calibrate(bool initial)
+{
+    std::uint64_t ticks;
+    std::int64_t ns;
+    double nsPerTick = ns_per_tick_.load(std::memory_order_relaxed);
+
+    if (initial) {
+        sample(origin_ticks_, origin_ns_);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        sample(ticks, ns);
+        nsPerTick = (double)(ns - origin_ns_) / (double)(ticks - origin_ticks_);
+    }
+    else {
+        // The rate is measured from the origin, more accurate as time goes by, unless
+        // the wall clock was stepped (prediction off by more than a millisecond), so
+        // measuring starts again from here
+        sample(ticks, ns);
+        double predicted = (double)base_ns_.load(std::memory_order_relaxed) + (double)(std::int64_t)(ticks - base_ticks_.load(std::memory_order_relaxed)) * nsPerTick;
+        if (std::fabs((double)ns - predicted) > 1e6) {
+            origin_ticks_ = ticks;
+            origin_ns_ = ns;
+        }
+        else {
+            nsPerTick = (double)(ns - origin_ns_) / (double)(ticks - origin_ticks_);
+        }
+    }
+
+    std::uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    base_ticks_.store(ticks, std::memory_order_release);
+    base_ns_.store(ns, std::memory_order_release);
+    ns_per_tick_.store(nsPerTick, std::memory_order_release);
+    sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+void Clock::run(std::chrono::milliseconds period)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!cv_.wait_for(lock, period, [] { return stopping_; })) calibrate(false);
+}
+
+}
+}
@@ -0,0 +1,281 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <ert/tracing/Configuration.hpp>
+#include <ert/tracing/Logger.hpp>
+
+
+namespace ert {
+namespace tracing {
+
+namespace {
+
+struct sigaction previous_hangup;
+
+std::string trim(const std::string &text)
+{
+    const char *blanks = " \t\r\n";
+    std::size_t begin = text.find_first_not_of(blanks);
+    if (begin == std::string::npos) return std::string();
+    return text.substr(begin, text.find_last_not_of(blanks) - begin + 1);
+}
+
+bool parseBoolean(const std::string &value, int &result)
+{
+    if (value == "true" || value == "yes" || value == "on" || value == "1") result = 1;
+    else if (value == "false" || value == "no" || value == "off" || value == "0") result = 0;
+    else return false;
+    return true;
+}
+
+}
+
+bool Configuration::parse(const std::string &text, std::string &error)
+{
+    std::istringstream input(text);
+    std::string line;
+    int number = 0;
+
+    while (std::getline(input, line)) {
+        number++;
+        std::size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        line = trim(line);
+        if (line.empty()) continue;
+
+        std::size_t equal = line.find('=');
+        if (equal == std::string::npos) {
+            error = "line " + std::to_string(number) + ": missing '='";
+            return false;
+        }
+        std::string key = trim(line.substr(0, equal));
+        std::string value = trim(line.substr(equal + 1));
+
+        bool valid = true;
+        if (key == "level") {
+            level = Logger::stringAsLevel(value);
+            valid = (level != -1);
+        }
+        else if (key == "verbose") {
+            valid = parseBoolean(value, verbose);
+        }
+        else if (key.compare(0, 9, "category.") == 0 && key.size() > 9) {
+            int category = (value == "default") ? -1 : Logger::stringAsLevel(value);
+            valid = (category != -1 || value == "default");
+            if (valid) categories[key.substr(9)] = category;
+        }
+        else if (key.compare(0, 9, "sampling.") == 0) {
+            int sampled = Logger::stringAsLevel(key.substr(9));
+            char *end = nullptr;
+            double rate = std::strtod(value.c_str(), &end);
+            valid = (sampled != -1 && !value.empty() && *end == '\0' && rate >= 0 && rate <= 1);
+            if (valid) sampling[sampled & 7] = rate;
+        }
+        else {
+            error = "line " + std::to_string(number) + ": unknown key '" + key + "'";
+            return false;
+        }
+
+        if (!valid) {
+            error = "line " + std::to_string(number) + ": invalid value '" + value + "' for '" + key + "'";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::mutex ConfigWatcher::mutex_;
+std::thread ConfigWatcher::watcher_;
+int ConfigWatcher::pipe_[2] = { -1, -1 };
+std::atomic<int> ConfigWatcher::signal_fd_(-1);
+std::string ConfigWatcher::path_;
+std::string ConfigWatcher::applied_;
+
+bool ConfigWatcher::start(const std::string &path, bool hangup)
+{
+    stop();
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    path_ = path;
+    applied_.clear();
+
+    if (pipe2(pipe_, O_CLOEXEC | O_NONBLOCK) != 0) return false;
+
+    // The directory is watched because files are usually replaced (editors, ConfigMaps):
+    std::size_t slash = path.rfind('/');
+    std::string directory = (slash == std::string::npos) ? "." : (slash == 0) ? "/" : path.substr(0, slash);
+    int inotify = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+    if (inotify != -1 && inotify_add_watch(inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) == -1) {
+        close(inotify);
+        inotify = -1;
+    }
+
+    if (hangup) {
+        signal_fd_.store(pipe_[1], std::memory_order_release);
+        struct sigaction action {};
+        action.sa_handler = onHangup;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESTART;
+        sigaction(SIGHUP, &action, &previous_hangup);
+    }
+
+    bool result = reload(true);
+    watcher_ = std::thread(watch, inotify);
+    return result;
+}
+
+void ConfigWatcher::stop()
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (!watcher_.joinable()) return;
+
+    if (signal_fd_.exchange(-1, std::memory_order_acq_rel) != -1) sigaction(SIGHUP, &previous_hangup, nullptr);
+
+    char command = 's';
+    while (write(pipe_[1], &command, 1) == -1 && errno == EINTR) {}
+    watcher_.join();
+
+    close(pipe_[0]);
+    close(pipe_[1]);
+    pipe_[0] = pipe_[1] = -1;
+}
+
+bool ConfigWatcher::load(const std::string &path)
+{
+    std::ifstream file(path);
+    if (!file) return false;
+    std::stringstream content;
+    content << file.rdbuf();
+
+    Configuration configuration;
+    std::string error;
+    if (!configuration.parse(content.str(), error)) return false;
+
+    Logger::configure(configuration);
+    return true;
+}
+
+void ConfigWatcher::watch(int inotify)
+{
+    std::size_t slash = path_.rfind('/');
+    std::string name = (slash == std::string::npos) ? path_ : path_.substr(slash + 1);
+
+    struct pollfd fds[2] = { { pipe_[0], POLLIN, 0 }, { inotify, POLLIN, 0 } };
+    alignas(struct inotify_event) char events[4096];
+
+    for (;;) {
+        if (poll(fds, (inotify != -1) ? 2 : 1, -1) == -1) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        if (fds[0].revents) {
+            char command;
+            bool stopping = false, reloading = false;
+            while (read(pipe_[0], &command, 1) == 1) {
+                if (command == 's') stopping = true;
+                else reloading = true;
+            }
+            if (stopping) break;
+            if (reloading) reload(true);
+        }
+
+        if (inotify != -1 && fds[1].revents) {
+            bool changed = false;
+            ssize_t size;
+            while ((size = read(inotify, events, sizeof(events))) > 0) {
+                for (char *p = events; p < events + size; ) {
+                    const struct inotify_event *event = (const struct inotify_event *)p;
+                    // Kubernetes ConfigMaps swap a '..data' symlink instead of the file:
+                    if (event->len && (name == event->name || std::strncmp(event->name, "..", 2) == 0)) changed = true;
+                    p += sizeof(struct inotify_event) + event->len;
+                }
+            }
+            if (changed) reload(false);
+        }
+    }
+
+    if (inotify != -1) close(inotify);
+}
+
+bool ConfigWatcher::reload(bool force)
+{
+    std::ifstream file(path_);
+    if (!file) {
+        Logger::error("Cannot read logger configuration '" + path_ + "'", ERT_FILE_LOCATION);
+        return false;
+    }
+    std::stringstream content;
+    content << file.rdbuf();
+    if (!force && content.str() == applied_) return true;
+
+    Configuration configuration;
+    std::string error;
+    if (!configuration.parse(content.str(), error)) {
+        Logger::error("Invalid logger configuration '" + path_ + "' (ignored), " + error, ERT_FILE_LOCATION);
+        return false;
+    }
+
+    Logger::configure(configuration);
+    applied_ = content.str();
+    return true;
+}
+
+void ConfigWatcher::onHangup(int)
+{
+    int fd = signal_fd_.load(std::memory_order_acquire);
+    if (fd == -1) return;
+    int saved = errno;
+    char command = 'h';
+    ssize_t written = write(fd, &command, 1);
+    (void)written;
+    errno = saved;
+}
+
+}
+}
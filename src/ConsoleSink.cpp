@@ -0,0 +1,288 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <errno.h>
+#include <limits.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include <ert/tracing/ConsoleSink.hpp>
+#include <ert/tracing/Logger.hpp>
+
+
+namespace ert {
+namespace tracing {
+
+std::mutex ConsoleSink::buffers_mutex_;
+std::vector<ConsoleSink::ThreadBuffer*> ConsoleSink::buffers_;
+std::atomic<int> ConsoleSink::nowait_mode_[3] = {};
+
+namespace {
+
+enum NoWaitMode { NoWait, PollFirst, NeverBlocks }; // nowait_mode_ values
+
+std::uint64_t countLines(const struct iovec *iov, int count)
+{
+    std::uint64_t result = 0;
+    for (int k = 0; k < count; k++) {
+        const char *p = (const char *)iov[k].iov_base;
+        result += std::count(p, p + iov[k].iov_len, '\n');
+    }
+    return std::max(result, (std::uint64_t)1);
+}
+
+}
+
+ConsoleSink::ThreadBuffer::ThreadBuffer()
+{
+    std::lock_guard<std::mutex> guard(buffers_mutex_);
+    buffers_.push_back(this);
+}
+
+ConsoleSink::ThreadBuffer::~ThreadBuffer()
+{
+    std::lock_guard<std::mutex> guard(buffers_mutex_);
+    buffers_.erase(std::remove(buffers_.begin(), buffers_.end(), this), buffers_.end());
+    std::lock_guard<std::mutex> buffer_guard(mutex);
+    ConsoleSink::flush(*this, nullptr);
+}
+
+ConsoleSink::ThreadBuffer &ConsoleSink::threadBuffer()
+{
+    thread_local ThreadBuffer result;
+    return result;
+}
+
+ConsoleSink::ConsoleSink(const ConsoleSinkOptions &options) : timestamps_(options.timestamps), buffer_size_(options.bufferSize), non_blocking_(options.nonBlocking), drops_(0),
+    flush_interval_(options.flushInterval), stopping_(false)
+{
+    std::lock_guard<std::mutex> guard(configure_mutex_);
+    startFlusher();
+}
+
+ConsoleSink::~ConsoleSink()
+{
+    {
+        std::lock_guard<std::mutex> guard(configure_mutex_);
+        stopFlusher();
+    }
+    flush();
+}
+
+void ConsoleSink::configure(const ConsoleSinkOptions &options)
+{
+    std::lock_guard<std::mutex> guard(configure_mutex_);
+    stopFlusher();
+    flush();
+    timestamps_.store(options.timestamps, std::memory_order_relaxed);
+    non_blocking_.store(options.nonBlocking, std::memory_order_relaxed);
+    buffer_size_.store(options.bufferSize, std::memory_order_relaxed);
+    flush_interval_ = options.flushInterval;
+    startFlusher();
+}
+
+void ConsoleSink::startFlusher()
+{
+    if (!buffer_size_.load(std::memory_order_relaxed)) return;
+    stopping_ = false;
+    flusher_ = std::thread(&ConsoleSink::flushPeriodically, this);
+}
+
+void ConsoleSink::stopFlusher()
+{
+    if (!flusher_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> guard(flusher_mutex_);
+        stopping_ = true;
+        flusher_cv_.notify_one();
+    }
+    flusher_.join();
+}
+
+ssize_t ConsoleSink::writeNoWait(int fd, const struct iovec *iov, int count)
+{
+    // One system call where supported (pipes, sockets), else poll() first. Regular
+    // files never block: written directly.
+    std::atomic<int> &mode = nowait_mode_[(fd == STDERR_FILENO) ? 2 : 1];
+#ifdef RWF_NOWAIT
+    if (mode.load(std::memory_order_relaxed) == NoWait) {
+        ssize_t result = pwritev2(fd, iov, count, -1, RWF_NOWAIT);
+        if (result >= 0 || (errno != EOPNOTSUPP && errno != EINVAL)) return result;
+        struct stat st;
+        mode.store((fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) ? NeverBlocks : PollFirst, std::memory_order_relaxed);
+    }
+#else
+    mode.store(PollFirst, std::memory_order_relaxed);
+#endif
+
+    if (mode.load(std::memory_order_relaxed) == PollFirst) {
+        struct pollfd pfd = { fd, POLLOUT, 0 };
+        if (poll(&pfd, 1, 0) != 1 || !(pfd.revents & POLLOUT)) {
+            errno = EAGAIN;
+            return -1;
+        }
+    }
+    return writev(fd, iov, count);
+}
+
+bool ConsoleSink::output(int fd, const struct iovec *iov, int count, std::atomic<std::uint64_t> *drops)
+{
+    // drops is provided in non-blocking mode: once the first bytes went out the rest
+    // follows (blocking), so lines are never cut
+    std::vector<struct iovec> pending;
+    bool nowait = (drops != nullptr);
+
+    while (count > 0) {
+        ssize_t written = nowait ? writeNoWait(fd, iov, count) : writev(fd, iov, count);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            if (drops) drops->fetch_add(nowait ? countLines(iov, count) : 1, std::memory_order_relaxed);
+            return false;
+        }
+        nowait = false;
+
+        // Partial write (large data): skip what was written and go on
+        while (count > 0 && (std::size_t)written >= iov->iov_len) {
+            written -= iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0 && written > 0) {
+            if (pending.empty()) {
+                pending.assign(iov, iov + count);
+                iov = pending.data();
+            }
+            struct iovec &first = pending[iov - pending.data()];
+            first.iov_base = (char *)first.iov_base + written;
+            first.iov_len -= written;
+        }
+    }
+    return true;
+}
+
+void ConsoleSink::flush(ThreadBuffer &buffer, std::atomic<std::uint64_t> *drops)
+{
+    for (int k = 0; k < 2; k++) {
+        std::string &data = buffer.data[k];
+        if (data.empty()) continue;
+        const int fd = k ? STDERR_FILENO : STDOUT_FILENO;
+        if (!drops) {
+            struct iovec iov = { &data[0], data.size() };
+            output(fd, &iov, 1, drops);
+            data.clear();
+            continue;
+        }
+
+        // Non-blocking: chunks of whole lines up to PIPE_BUF (all or nothing on a pipe):
+        std::size_t begin = 0;
+        while (begin < data.size()) {
+            std::size_t end = data.size();
+            if (end - begin > PIPE_BUF) {
+                std::size_t last = data.rfind('\n', begin + PIPE_BUF - 1);
+                if (last == std::string::npos || last < begin) last = data.find('\n', begin); // longer line
+                if (last != std::string::npos) end = last + 1;
+            }
+            struct iovec iov = { &data[begin], end - begin };
+            if (!output(fd, &iov, 1, drops)) {
+                if (end < data.size()) drops->fetch_add(std::count(data.begin() + end, data.end(), '\n'), std::memory_order_relaxed);
+                break;
+            }
+            begin = end;
+        }
+        data.clear();
+    }
+}
+
+void ConsoleSink::write(const Record &record)
+{
+    char timestamp[LocaltimeSize + 2];
+    std::size_t timestampSize = 0;
+    if (timestamps_.load(std::memory_order_relaxed)) {
+        timestampSize = getLocaltime(timestamp, LocaltimeSize, Clock::toTime(record.time));
+        timestamp[timestampSize++] = ':';
+        timestamp[timestampSize++] = ' ';
+    }
+
+    const int stream = (record.level <= LOG_ERR) ? 1 : 0;
+    std::atomic<std::uint64_t> *drops = non_blocking_.load(std::memory_order_relaxed) ? &drops_ : nullptr;
+
+    const std::size_t bufferSize = buffer_size_.load(std::memory_order_relaxed);
+    if (!bufferSize) {
+        struct iovec iov[3] = {
+            { timestamp, timestampSize },
+            { (void *)record.text, record.size },
+            { (void *)"\n", 1 }
+        };
+        output(stream ? STDERR_FILENO : STDOUT_FILENO, iov, 3, drops);
+        return;
+    }
+
+    ThreadBuffer &buffer = threadBuffer();
+    std::lock_guard<std::mutex> guard(buffer.mutex); // uncontended but for the flusher
+    std::string &data = buffer.data[stream];
+    data.append(timestamp, timestampSize).append(record.text, record.size).push_back('\n');
+    if (data.size() >= bufferSize) flush(buffer, drops);
+}
+
+void ConsoleSink::flush()
+{
+    std::atomic<std::uint64_t> *drops = non_blocking_.load(std::memory_order_relaxed) ? &drops_ : nullptr;
+    std::lock_guard<std::mutex> guard(buffers_mutex_);
+    for (ThreadBuffer *buffer : buffers_) {
+        std::lock_guard<std::mutex> buffer_guard(buffer->mutex);
+        flush(*buffer, drops);
+    }
+}
+
+void ConsoleSink::flushPeriodically()
+{
+    std::unique_lock<std::mutex> lock(flusher_mutex_);
+    while (!stopping_) {
+        flusher_cv_.wait_for(lock, flush_interval_);
+        if (stopping_) break;
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+}
+
+}
+}
+
@@ -0,0 +1,245 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <charconv>
+#include <ctime>
+#include <thread>
+
+#include <ert/tracing/Clock.hpp>
+#include <ert/tracing/DatagramSink.hpp>
+
+
+namespace ert {
+namespace tracing {
+
+namespace {
+
+void putDigits(char *dest, unsigned int value, int digits)
+{
+    for (int k = digits - 1; k >= 0; k--, value /= 10) dest[k] = '0' + value % 10;
+}
+
+}
+
+DatagramSink::DatagramSink(const DatagramSinkOptions &options) : options_(options), pid_(getpid()), fd_(-1), cached_second_(-1), cached_time_size_(0), drops_(0), sent_(0), retries_(0)
+{
+    if (options_.batch == 0) options_.batch = 1;
+
+    std::string ident = options_.ident.empty() ? program_invocation_short_name : options_.ident;
+    std::string pid = std::to_string(pid_);
+
+    if (options_.format == DatagramSinkOptions::Rfc5424) {
+        char hostname[256] = "-";
+        if (gethostname(hostname, sizeof(hostname)) != 0 || !hostname[0]) strcpy(hostname, "-");
+        hostname[sizeof(hostname) - 1] = '\0';
+        header_head_ = std::string(" ") + hostname + " " + ident + " ";
+        header_tail_ = " - - ";
+        header_ = header_head_ + (options_.pid ? pid:"-") + header_tail_;
+    }
+    else {
+        header_head_ = " " + ident + "[";
+        header_tail_ = "]: ";
+        header_ = " " + ident + (options_.pid ? ("[" + pid + "]"):"") + ": ";
+    }
+
+    frames_.reserve(options_.batch * 256);
+    ends_.reserve(options_.batch);
+    last_connect_ = std::chrono::steady_clock::now() - options_.reconnectInterval;
+    connect();
+}
+
+DatagramSink::~DatagramSink()
+{
+    flush();
+    if (fd_ >= 0) close(fd_);
+}
+
+bool DatagramSink::connect()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (now - last_connect_ < options_.reconnectInterval) return false;
+    last_connect_ = now;
+
+    if (fd_ >= 0) close(fd_);
+    fd_ = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC | (options_.nonBlocking ? SOCK_NONBLOCK:0), 0);
+    if (fd_ < 0) return false;
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, options_.path.c_str(), sizeof(addr.sun_path) - 1);
+
+    if (::connect(fd_, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    return true;
+}
+
+void DatagramSink::appendTimestamp(std::chrono::system_clock::time_point when)
+{
+    auto unix_usecs = std::chrono::duration_cast<std::chrono::microseconds>(when.time_since_epoch()).count();
+    std::time_t second = unix_usecs / 1000000;
+
+    if (second != cached_second_) {
+        std::tm timeinfo;
+        if (options_.format == DatagramSinkOptions::Rfc5424) {
+            // '2023-08-02T19:16:46' (UTC, fraction and 'Z' appended below)
+            gmtime_r(&second, &timeinfo);
+            cached_time_size_ = strftime(cached_time_, sizeof(cached_time_), "%Y-%m-%dT%H:%M:%S", &timeinfo);
+        }
+        else {
+            // 'Aug  2 19:16:46' (local time)
+            localtime_r(&second, &timeinfo);
+            cached_time_size_ = strftime(cached_time_, sizeof(cached_time_), "%b %e %H:%M:%S", &timeinfo);
+        }
+        cached_second_ = second;
+    }
+
+    frames_.append(cached_time_, cached_time_size_);
+    if (options_.format == DatagramSinkOptions::Rfc5424) {
+        char fraction[9] = ".000000Z";
+        putDigits(fraction + 1, unix_usecs % 1000000, 6);
+        frames_.append(fraction, 8);
+    }
+}
+
+void DatagramSink::write(const Record &record)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+
+    char pri[8] = "<";
+    auto res = std::to_chars(pri + 1, pri + sizeof(pri) - 1, (options_.facility & LOG_FACMASK) | (record.level & LOG_PRIMASK));
+    *res.ptr++ = '>';
+    frames_.append(pri, res.ptr - pri);
+    if (options_.format == DatagramSinkOptions::Rfc5424) frames_.append("1 ");
+
+    appendTimestamp(Clock::toTime(record.time));
+    if (options_.pid && record.pid && record.pid != pid_) {
+        char pid[16];
+        auto end = std::to_chars(pid, pid + sizeof(pid), record.pid).ptr;
+        frames_.append(header_head_);
+        frames_.append(pid, end - pid);
+        frames_.append(header_tail_);
+    }
+    else {
+        frames_.append(header_);
+    }
+    frames_.append(record.text, record.size);
+    ends_.push_back(frames_.size());
+
+    if (ends_.size() >= options_.batch) send();
+}
+
+void DatagramSink::flush()
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (!ends_.empty()) send();
+}
+
+void DatagramSink::send()
+{
+    const std::size_t n = ends_.size();
+    std::vector<struct iovec> &iovs = iovs_;
+    std::vector<struct mmsghdr> &msgs = msgs_;
+    iovs.resize(n);
+    msgs.resize(n);
+
+    std::size_t begin = 0;
+    for (std::size_t k = 0; k < n; k++) {
+        iovs[k].iov_base = &frames_[begin];
+        iovs[k].iov_len = ends_[k] - begin;
+        memset(&msgs[k], 0, sizeof(msgs[k]));
+        msgs[k].msg_hdr.msg_iov = &iovs[k];
+        msgs[k].msg_hdr.msg_iovlen = 1;
+        begin = ends_[k];
+    }
+
+    std::size_t index = 0;
+    int retries = 0;
+    while (index < n) {
+        if (fd_ < 0 && (!options_.reconnect || !connect())) break;
+
+        int count = std::min(n - index, options_.batch);
+        int rc = sendmmsg(fd_, &msgs[index], count, MSG_NOSIGNAL);
+        if (rc > 0) {
+            sent_.fetch_add(rc, std::memory_order_relaxed);
+            index += rc;
+            retries = 0;
+            continue;
+        }
+
+        int error = (rc == 0) ? EAGAIN : errno;
+        if (error == EINTR) continue;
+
+        if (error == ENOBUFS || error == EAGAIN) {
+            if (retries++ < options_.enobufsRetries) {
+                retries_.fetch_add(1, std::memory_order_relaxed);
+                std::this_thread::sleep_for(options_.enobufsWait);
+                continue;
+            }
+            drops_.fetch_add(1, std::memory_order_relaxed);
+            index++;
+            retries = 0;
+        }
+        else if (error == EMSGSIZE) {
+            drops_.fetch_add(1, std::memory_order_relaxed);
+            index++;
+        }
+        else {
+            // Daemon gone (ECONNREFUSED, ENOTCONN, ENOENT ...): reconnection is tried on next loop
+            close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    if (index < n) drops_.fetch_add(n - index, std::memory_order_relaxed);
+
+    frames_.clear();
+    ends_.clear();
+}
+
+}
+}
+
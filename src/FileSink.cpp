@@ -0,0 +1,331 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+#include <ert/tracing/FileSink.hpp>
+#include <ert/tracing/Logger.hpp>
+
+
+namespace ert {
+namespace tracing {
+
+FileSink::FileSink(const FileSinkOptions &options) : options_(options), current_(nullptr), drops_(0), spare_(nullptr), renaming_(false), attempts_(0), stopping_(false), wake_(true)
+{
+    options_.segmentSize = std::max(options_.segmentSize, (std::size_t)4096);
+    next_path_ = options_.path + ".next";
+
+    // Previous file (if any) is rotated instead of being overwritten:
+    shiftFiles();
+    current_.store(createSegment(options_.path), std::memory_order_seq_cst);
+
+    syncer_ = std::thread(&FileSink::sync, this); // prepares the next segment at once
+}
+
+FileSink::~FileSink()
+{
+    {
+        std::lock_guard<std::mutex> guard(syncer_mutex_);
+        stopping_ = true;
+        syncer_cv_.notify_one();
+    }
+    syncer_.join();
+
+    if (renaming_) {
+        shiftFiles();
+        rename(next_path_.c_str(), options_.path.c_str());
+    }
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (spare_) {
+        release(spare_);
+        unlink(next_path_.c_str());
+    }
+    Segment *segment = current_.exchange(nullptr, std::memory_order_seq_cst);
+    if (segment) retired_.push_back(segment);
+    releaseRetired(true);
+}
+
+FileSink::Segment *FileSink::createSegment(const std::string &path)
+{
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return nullptr;
+
+    if (posix_fallocate(fd, 0, options_.segmentSize) != 0 && ftruncate(fd, options_.segmentSize) != 0) {
+        close(fd);
+        return nullptr;
+    }
+
+    void *data = mmap(nullptr, options_.segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        close(fd);
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    Segment *result;
+    if (free_.empty()) {
+        segments_.emplace_back(new Segment);
+        result = segments_.back().get();
+    }
+    else {
+        result = free_.back();
+        free_.pop_back();
+    }
+
+    // Writers counter is kept: stale writers always balance their increments
+    result->offset.store(0, std::memory_order_relaxed);
+    result->end.store(0, std::memory_order_relaxed);
+    result->fd = fd;
+    result->data = (char *)data;
+    result->size = options_.segmentSize;
+    result->created = std::chrono::steady_clock::now();
+    return result;
+}
+
+void FileSink::shiftFiles()
+{
+    struct stat st;
+    if (stat(options_.path.c_str(), &st) != 0) return;
+
+    if (options_.keep == 0) {
+        unlink(options_.path.c_str());
+        return;
+    }
+    unlink((options_.path + "." + std::to_string(options_.keep)).c_str());
+    for (unsigned int k = options_.keep - 1; k >= 1; k--) {
+        rename((options_.path + "." + std::to_string(k)).c_str(), (options_.path + "." + std::to_string(k + 1)).c_str());
+    }
+    rename(options_.path.c_str(), (options_.path + ".1").c_str());
+}
+
+void FileSink::prepare()
+{
+    for (;;) {
+        bool renaming, needed;
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            renaming = renaming_;
+            needed = !spare_;
+        }
+
+        // No rotation can happen meanwhile: the prepared segment was consumed.
+        // Open descriptors are not affected by the renames:
+        if (renaming) {
+            shiftFiles();
+            rename(next_path_.c_str(), options_.path.c_str());
+            std::lock_guard<std::mutex> guard(mutex_);
+            renaming_ = false;
+        }
+        if (!needed) return;
+
+        Segment *segment = createSegment(next_path_);
+        std::lock_guard<std::mutex> guard(mutex_);
+        attempts_++;
+        spare_cv_.notify_all();
+        if (!segment) return; // retried in the next period, records dropped meanwhile
+        if (current_.load(std::memory_order_seq_cst)) {
+            spare_ = segment;
+            return;
+        }
+        current_.store(segment, std::memory_order_seq_cst); // retry after failure
+        renaming_ = true;
+    }
+}
+
+void FileSink::wakeSyncer()
+{
+    std::lock_guard<std::mutex> guard(syncer_mutex_);
+    wake_ = true;
+    syncer_cv_.notify_one();
+}
+
+void FileSink::rotate(Segment *full, std::unique_lock<std::mutex> &lock, bool wait)
+{
+    if (current_.load(std::memory_order_seq_cst) != full) return; // already rotated
+
+    if (!spare_) {
+        // Rotations faster than segment creation (or creation failed):
+        if (!wait) return;
+        const std::uint64_t attempts = attempts_;
+        wakeSyncer();
+        spare_cv_.wait(lock, [this, attempts] { return spare_ || attempts_ != attempts; });
+        if (current_.load(std::memory_order_seq_cst) != full) return;
+    }
+
+    Segment *next = spare_;
+    spare_ = nullptr;
+    if (next) {
+        next->created = std::chrono::steady_clock::now();
+        renaming_ = true;
+    }
+    retired_.push_back(full);
+    current_.store(next, std::memory_order_seq_cst); // null: records dropped until the syncer retries
+    wakeSyncer();
+}
+
+void FileSink::release(Segment *segment)
+{
+    std::size_t used = segment->end.load(std::memory_order_acquire);
+    if (!used) used = std::min(segment->offset.load(std::memory_order_acquire), segment->size);
+
+    munmap(segment->data, segment->size);
+    if (ftruncate(segment->fd, used) != 0) {} // keep preallocated size on failure
+    close(segment->fd);
+    free_.push_back(segment);
+}
+
+void FileSink::releaseRetired(bool wait)
+{
+    auto it = retired_.begin();
+    while (it != retired_.end()) {
+        Segment *segment = *it;
+        if (wait) {
+            while (segment->writers.load(std::memory_order_seq_cst) != 0) std::this_thread::yield();
+        }
+        else if (segment->writers.load(std::memory_order_seq_cst) != 0) {
+            ++it;
+            continue;
+        }
+
+        release(segment);
+        it = retired_.erase(it);
+    }
+}
+
+void FileSink::write(const Record &record)
+{
+    char timestamp[LocaltimeSize];
+    std::size_t timestampSize = options_.timestamps ? getLocaltime(timestamp, sizeof(timestamp), Clock::toTime(record.time)) : 0;
+    char pid[16];
+    std::size_t pidSize = record.pid ? std::to_chars(pid, pid + sizeof(pid), record.pid).ptr - pid : 0;
+    const std::size_t size = (timestampSize ? timestampSize + 2 : 0) + (pidSize ? pidSize + 1 : 0) + record.size + 1;
+
+    if (size > options_.segmentSize) {
+        drops_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    for (;;) {
+        Segment *segment = current_.load(std::memory_order_seq_cst);
+        if (!segment) {
+            drops_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        // Segment must still be current once registered as writer, so it is not released under us:
+        segment->writers.fetch_add(1, std::memory_order_seq_cst);
+        if (current_.load(std::memory_order_seq_cst) != segment) {
+            segment->writers.fetch_sub(1, std::memory_order_release);
+            continue;
+        }
+
+        std::size_t offset = segment->offset.fetch_add(size, std::memory_order_relaxed);
+        if (offset + size <= segment->size) {
+            char *p = segment->data + offset;
+            if (timestampSize) {
+                std::memcpy(p, timestamp, timestampSize);
+                p += timestampSize;
+                *p++ = ':';
+                *p++ = ' ';
+            }
+            if (pidSize) {
+                std::memcpy(p, pid, pidSize);
+                p += pidSize;
+                *p++ = '|';
+            }
+            std::memcpy(p, record.text, record.size);
+            p[record.size] = '\n';
+            segment->writers.fetch_sub(1, std::memory_order_release);
+            return;
+        }
+
+        if (offset <= segment->size) {
+            // First overflowing writer rotates (still registered, so the segment is not released meanwhile):
+            segment->end.store(offset, std::memory_order_release);
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                rotate(segment, lock, true);
+            }
+            segment->writers.fetch_sub(1, std::memory_order_release);
+        }
+        else {
+            segment->writers.fetch_sub(1, std::memory_order_release);
+            while (current_.load(std::memory_order_seq_cst) == segment) std::this_thread::yield();
+        }
+    }
+}
+
+void FileSink::sync()
+{
+    std::unique_lock<std::mutex> lock(syncer_mutex_);
+    while (!stopping_) {
+        if (!wake_) syncer_cv_.wait_for(lock, options_.syncInterval, [this] { return stopping_ || wake_; });
+        if (stopping_) break;
+        wake_ = false;
+        lock.unlock();
+
+        // Files shifted and next segment created away from the writers:
+        prepare();
+
+        {
+            std::unique_lock<std::mutex> guard(mutex_);
+            Segment *segment = current_.load(std::memory_order_seq_cst);
+            if (segment && options_.rotationInterval.count() > 0 && segment->offset.load(std::memory_order_relaxed) > 0 &&
+                    std::chrono::steady_clock::now() - segment->created >= options_.rotationInterval) {
+                rotate(segment, guard, false);
+            }
+            else if (segment) {
+                msync(segment->data, segment->size, MS_ASYNC);
+            }
+
+            releaseRetired(false);
+        }
+
+        lock.lock();
+    }
+}
+
+}
+}
+
@@ -0,0 +1,501 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+#include <ert/tracing/FlightRecorder.hpp>
+#include <ert/tracing/Logger.hpp>
+
+
+namespace ert {
+namespace tracing {
+
+namespace {
+
+std::mutex configuration_mutex;
+char dump_path[4096]; // empty: standard error
+std::atomic<bool> signals_installed(false);
+struct sigaction previous_actions[NSIG];
+std::atomic_flag dumping = ATOMIC_FLAG_INIT;
+
+constexpr int Signals[] = { SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL };
+
+// Alternate signal stack of the calling thread (handlers run with SA_ONSTACK), so a stack
+// overflow can still be dumped. Kept if the application installed its own:
+void installAlternateStack()
+{
+    struct AlternateStack {
+        std::unique_ptr<char[]> memory;
+        ~AlternateStack() {
+            if (!memory) return;
+            stack_t disable {};
+            disable.ss_flags = SS_DISABLE;
+            sigaltstack(&disable, nullptr);
+        }
+    };
+    thread_local AlternateStack stack;
+    if (stack.memory) return;
+
+    stack_t current;
+    if (sigaltstack(nullptr, &current) != 0 || !(current.ss_flags & SS_DISABLE)) return;
+
+    const std::size_t size = std::max((std::size_t)SIGSTKSZ, (std::size_t)65536);
+    stack.memory.reset(new char[size]);
+    stack_t alternate {};
+    alternate.ss_sp = stack.memory.get();
+    alternate.ss_size = size;
+    if (sigaltstack(&alternate, nullptr) != 0) stack.memory.reset();
+}
+
+// Record words after the sequence stamp:
+enum Word { Time, Thread, Meta, File, Function, Format, Payload };
+
+// Buffered output on a file descriptor, async-signal-safe
+class Output {
+    int fd_;
+    char data_[4096];
+    std::size_t size_;
+
+public:
+    explicit Output(int fd) : fd_(fd), size_(0) {}
+
+    void append(const char *text, std::size_t size) {
+        while (size) {
+            if (size_ == sizeof(data_)) flush();
+            std::size_t chunk = std::min(size, sizeof(data_) - size_);
+            std::memcpy(data_ + size_, text, chunk);
+            size_ += chunk;
+            text += chunk;
+            size -= chunk;
+        }
+    }
+
+    void append(const char *text) {
+        append(text, std::strlen(text));
+    }
+
+    template <typename T>
+    void appendNumber(T value, int base = 10) {
+        char aux[64];
+        auto res = std::to_chars(aux, aux + sizeof(aux), value, base);
+        append(aux, res.ptr - aux);
+    }
+
+    void appendDouble(double value) {
+        char aux[64];
+        auto res = std::to_chars(aux, aux + sizeof(aux), value);
+        append(aux, res.ptr - aux);
+    }
+
+    void flush() {
+        const char *p = data_;
+        while (size_) {
+            ssize_t written = ::write(fd_, p, size_);
+            if (written < 0 && errno == EINTR) continue;
+            if (written <= 0) break;
+            p += written;
+            size_ -= written;
+        }
+        size_ = 0;
+    }
+};
+
+void putDigits(char *dest, unsigned int value, int digits)
+{
+    for (int k = digits - 1; k >= 0; k--, value /= 10) dest[k] = '0' + value % 10;
+}
+
+// 'YYYY-MM-DD HH:MM:SS.uuuuuu GMT' without gmtime_r (civil from days, H. Hinnant)
+void appendTime(Output &out, std::uint64_t ns)
+{
+    std::int64_t seconds = ns / 1000000000;
+    std::int64_t days = seconds / 86400;
+    std::int64_t rest = seconds % 86400;
+
+    days += 719468;
+    std::int64_t era = days / 146097;
+    unsigned doe = days - era * 146097;
+    unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    unsigned mp = (5 * doy + 2) / 153;
+    unsigned day = doy - (153 * mp + 2) / 5 + 1;
+    unsigned month = mp < 10 ? mp + 3 : mp - 9;
+    unsigned year = yoe + era * 400 + (month <= 2);
+
+    char text[LocaltimeSize];
+    putDigits(text, year, 4);
+    text[4] = '-';
+    putDigits(text + 5, month, 2);
+    text[7] = '-';
+    putDigits(text + 8, day, 2);
+    text[10] = ' ';
+    putDigits(text + 11, rest / 3600, 2);
+    text[13] = ':';
+    putDigits(text + 14, rest % 3600 / 60, 2);
+    text[16] = ':';
+    putDigits(text + 17, rest % 60, 2);
+    text[19] = '.';
+    putDigits(text + 20, ns % 1000000000 / 1000, 6);
+    std::memcpy(text + 26, " GMT", 4);
+    out.append(text, LocaltimeSize - 1);
+}
+
+// Format text up to the next '{}' placeholder (see format::appendLiteral)
+const char *appendLiteral(Output &out, const char *format)
+{
+    const char *p = format;
+    for (;;) {
+        const char *start = p;
+        while (*p && *p != '{' && *p != '}') p++;
+        out.append(start, p - start);
+
+        if (!*p) return nullptr;
+        if (p[0] == '{' && p[1] == '}') return p + 2;
+        if (p[0] == p[1]) p++; // escaped brace
+        out.append(p++, 1);
+    }
+}
+
+// Renders one binary argument (see binary::encodeArgument)
+const char *appendArgument(Output &out, const char *p, const char *end)
+{
+    if (p >= end) return nullptr;
+    std::uint8_t tag = *p++;
+
+    auto get = [&](auto &value) {
+        if (end - p < (std::ptrdiff_t)sizeof(value)) return false;
+        std::memcpy(&value, p, sizeof(value));
+        p += sizeof(value);
+        return true;
+    };
+
+    switch (tag) {
+    case binary::Bool:
+    case binary::Char: {
+        char value;
+        if (!get(value)) return nullptr;
+        if (tag == binary::Bool) out.append(value ? "true":"false");
+        else out.append(&value, 1);
+        return p;
+    }
+    case binary::Int: {
+        std::int64_t value;
+        if (!get(value)) return nullptr;
+        out.appendNumber(value);
+        return p;
+    }
+    case binary::UInt: {
+        std::uint64_t value;
+        if (!get(value)) return nullptr;
+        out.appendNumber(value);
+        return p;
+    }
+    case binary::Double: {
+        double value;
+        if (!get(value)) return nullptr;
+        out.appendDouble(value);
+        return p;
+    }
+    case binary::String: {
+        std::uint32_t size;
+        if (!get(size) || end - p < (std::ptrdiff_t)size) return nullptr;
+        out.append(p, size);
+        return p + size;
+    }
+    case binary::Pointer: {
+        std::uint64_t value;
+        if (!get(value)) return nullptr;
+        out.append("0x");
+        out.appendNumber(value, 16);
+        return p;
+    }
+    }
+
+    return nullptr;
+}
+
+void render(Output &out, const std::uint64_t *record)
+{
+    std::uint64_t meta = record[Meta];
+    int level = meta & 0xff;
+    std::size_t size = (meta >> 8) & 0xffff;
+    int line = (int)(meta >> 32);
+    const char *file = (const char *)(std::uintptr_t)record[File];
+    const char *function = (const char *)(std::uintptr_t)record[Function];
+    const char *format = (const char *)(std::uintptr_t)record[Format];
+    const char *payload = (const char *)(record + Payload);
+
+    appendTime(out, Clock::toNanoseconds(record[Time]));
+    out.append(" [");
+    out.appendNumber(record[Thread]);
+    out.append("]: [");
+    const char *s_level = Logger::levelAsString((Logger::Level)level);
+    out.append(s_level ? s_level:"<level not supported>");
+    out.append("]|");
+    out.append(file);
+    out.append(":");
+    out.appendNumber(line);
+    out.append("(");
+    out.append(function);
+    out.append(")|");
+
+    if (!format) {
+        out.append(payload, size);
+    }
+    else {
+        const char *p = payload + 1, *end = payload + size;
+        for (std::uint8_t argc = payload[0]; argc && format; argc--) {
+            format = appendLiteral(out, format);
+            if (format && !(p = appendArgument(out, p, end))) break;
+        }
+        // Remaining text (placeholders of arguments not recorded are kept):
+        while (format && (format = appendLiteral(out, format))) out.append("{}");
+    }
+    out.append("\n");
+}
+
+}
+
+struct FlightRecorder::Ring {
+    Ring *next = nullptr; // immutable once published
+    std::atomic<bool> busy{false};
+    std::atomic<std::uint64_t> head{0}; // records written
+    std::uint64_t thread = 0; // owner thread id (owner only)
+    std::size_t mask;
+    std::size_t words; // per record, sequence stamp included
+    std::unique_ptr<std::atomic<std::uint64_t>[]> slots;
+
+    // Dump position (dumper only, dumps are serialized):
+    std::uint64_t cursor = 0;
+    std::uint64_t end = 0;
+
+    Ring(std::size_t capacity, std::size_t recordWords) : mask(capacity - 1), words(recordWords), slots(new std::atomic<std::uint64_t>[capacity * recordWords]) {
+        for (std::size_t k = 0; k < capacity * recordWords; k++) slots[k].store(0, std::memory_order_relaxed);
+    }
+
+    std::atomic<std::uint64_t> *slot(std::uint64_t n) {
+        return &slots[(n & mask) * words];
+    }
+
+    // Copies record n (sequence stamp excluded): false if overwritten or being written
+    bool read(std::uint64_t n, std::uint64_t *record, std::size_t count) {
+        std::atomic<std::uint64_t> *s = slot(n);
+        std::uint64_t stamp = s[0].load(std::memory_order_acquire);
+        if (stamp != 2 * n + 2) return false;
+        // Acquire loads: a word from a later writer makes the stamp check below fail
+        for (std::size_t k = 0; k < count; k++) record[k] = s[1 + k].load(std::memory_order_acquire);
+        return (s[0].load(std::memory_order_relaxed) == stamp);
+    }
+};
+
+std::atomic<FlightRecorder::Ring*> FlightRecorder::rings_(nullptr);
+std::atomic<std::size_t> FlightRecorder::words_(0);
+std::size_t FlightRecorder::capacity_ = 0;
+std::atomic<std::size_t> FlightRecorder::payload_size_(0);
+
+void FlightRecorder::configure(const FlightRecorderOptions &options)
+{
+    std::lock_guard<std::mutex> guard(configuration_mutex);
+
+    if (!words_.load(std::memory_order_relaxed)) {
+        std::size_t size = std::min(std::max(options.recordSize, HeaderSize + 8), MaxRecordSize) & ~(std::size_t)7;
+        std::size_t capacity = 1;
+        while (capacity < options.records) capacity <<= 1;
+        capacity_ = capacity;
+        payload_size_.store(size - HeaderSize, std::memory_order_relaxed);
+        words_.store(size / 8, std::memory_order_release);
+    }
+
+    std::size_t length = std::min(options.path.size(), sizeof(dump_path) - 1);
+    std::memcpy(dump_path, options.path.data(), length);
+    dump_path[length] = 0;
+
+    if (options.signals && !signals_installed.load(std::memory_order_relaxed)) {
+        struct sigaction action {};
+        action.sa_handler = onSignal;
+        action.sa_flags = SA_ONSTACK;
+        sigemptyset(&action.sa_mask);
+        for (int signal : Signals) sigaction(signal, &action, &previous_actions[signal]);
+        signals_installed.store(true, std::memory_order_release);
+    }
+    if (signals_installed.load(std::memory_order_relaxed)) installAlternateStack(); // configuring thread (normally main)
+}
+
+FlightRecorder::Ring *FlightRecorder::ring()
+{
+    struct Owner {
+        Ring *ring = nullptr;
+        ~Owner() {
+            if (ring) ring->busy.store(false, std::memory_order_release); // records are kept until reused
+        }
+    };
+    thread_local Owner owner;
+    if (ERT_LIKELY(owner.ring != nullptr)) return owner.ring;
+
+    std::size_t words = words_.load(std::memory_order_acquire);
+    if (!words) return nullptr;
+
+    for (Ring *r = rings_.load(std::memory_order_acquire); r && !owner.ring; r = r->next) {
+        bool expected = false;
+        if (r->busy.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) owner.ring = r;
+    }
+
+    if (!owner.ring) {
+        Ring *r = new Ring(capacity_, words);
+        r->busy.store(true, std::memory_order_relaxed);
+        r->next = rings_.load(std::memory_order_relaxed);
+        while (!rings_.compare_exchange_weak(r->next, r, std::memory_order_acq_rel)) {}
+        owner.ring = r;
+    }
+
+    owner.ring->thread = (std::uint64_t)::syscall(SYS_gettid);
+    if (signals_installed.load(std::memory_order_acquire)) installAlternateStack(); // recording threads
+    return owner.ring;
+}
+
+void FlightRecorder::record(int level, const char *file, int line, const char *function, const char *text, std::size_t size)
+{
+    commit(level, file, line, function, nullptr, text, size);
+}
+
+void FlightRecorder::commit(int level, const char *file, int line, const char *function, const char *format, const char *payload, std::size_t size)
+{
+    Ring *r = ring();
+    if (!r) return;
+
+    std::size_t payloadWords = r->words - 1 - Payload;
+    if (size > payloadWords * 8) size = payloadWords * 8;
+
+    std::uint64_t n = r->head.load(std::memory_order_relaxed);
+    std::atomic<std::uint64_t> *s = r->slot(n);
+    // Odd stamp while writing. Words are stored with release ordering (plain stores
+    // on x86) so a reader seeing any of them sees the odd stamp too:
+    s[0].store(2 * n + 1, std::memory_order_relaxed);
+
+    std::uint64_t time = Clock::now(); // converted when dumped
+    if (!time) time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    s[1 + Time].store(time, std::memory_order_release);
+    s[1 + Thread].store(r->thread, std::memory_order_release);
+    s[1 + Meta].store((std::uint64_t)(level & 0xff) | ((std::uint64_t)size << 8) | ((std::uint64_t)(std::uint32_t)line << 32), std::memory_order_release);
+    s[1 + File].store((std::uintptr_t)file, std::memory_order_release);
+    s[1 + Function].store((std::uintptr_t)function, std::memory_order_release);
+    s[1 + Format].store((std::uintptr_t)format, std::memory_order_release);
+    for (std::size_t k = 0; k * 8 < size; k++) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, payload + k * 8, std::min<std::size_t>(8, size - k * 8));
+        s[1 + Payload + k].store(word, std::memory_order_release);
+    }
+
+    s[0].store(2 * n + 2, std::memory_order_release);
+    r->head.store(n + 1, std::memory_order_release);
+}
+
+bool FlightRecorder::dump()
+{
+    if (!dump_path[0]) return dump(STDERR_FILENO);
+
+    int fd = ::open(dump_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+    bool result = dump(fd);
+    ::close(fd);
+    return result;
+}
+
+bool FlightRecorder::dump(int fd)
+{
+    if (dumping.test_and_set(std::memory_order_acquire)) return false;
+
+    std::size_t words = words_.load(std::memory_order_acquire);
+    Output out(fd);
+    out.append("--- flight recorder dump ---\n");
+
+    Ring *first = rings_.load(std::memory_order_acquire);
+    for (Ring *r = first; r; r = r->next) {
+        r->end = r->head.load(std::memory_order_acquire);
+        r->cursor = (r->end > capacity_) ? r->end - capacity_ : 0;
+    }
+
+    // Merge rings in time order:
+    std::uint64_t record[MaxRecordSize / 8];
+    for (;;) {
+        Ring *next = nullptr;
+        std::int64_t next_time = 0;
+        for (Ring *r = first; r; r = r->next) {
+            for (; r->cursor < r->end; r->cursor++) {
+                std::uint64_t stamp;
+                if (!r->read(r->cursor, &stamp, 1)) continue; // overwritten meanwhile
+                std::int64_t time = Clock::toNanoseconds(stamp); // TSC and nanosecond stamps may coexist
+                if (!next || time < next_time) {
+                    next = r;
+                    next_time = time;
+                }
+                break;
+            }
+        }
+        if (!next) break;
+
+        if (next->read(next->cursor, record, words - 1)) render(out, record);
+        next->cursor++;
+    }
+
+    out.append("--- end of flight recorder dump ---\n");
+    out.flush();
+    dumping.clear(std::memory_order_release);
+    return true;
+}
+
+void FlightRecorder::onSignal(int signal)
+{
+    dump();
+
+    // Default (or previous) behaviour:
+    sigaction(signal, &previous_actions[signal], nullptr);
+    raise(signal);
+}
+
+}
+}
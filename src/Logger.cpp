@@ -36,51 +36,646 @@ SOFTWARE.
 #include <stdio.h>
 #include <stdarg.h>
 #include <ctime>
+#include <cstring>
 
-#include <iostream>
-#include <iomanip>
 #include <chrono>
+#include <charconv>
 
 #include <ert/tracing/Logger.hpp>
+#include <ert/tracing/RecordQueue.hpp>
+#include <ert/tracing/SyslogSink.hpp>
 
 
 namespace ert {
 namespace tracing {
 
-std::string getLocaltime()
+namespace {
+
+void putDigits(char *dest, unsigned int value, int digits)
+{
+    for (int k = digits - 1; k >= 0; k--, value /= 10) dest[k] = '0' + value % 10;
+}
+
+// Sampling threshold over 32-bit random values (above 0xffffffff: no sampling)
+std::uint64_t samplingThreshold(double rate)
+{
+    return (rate >= 1) ? (1ULL << 32) : (rate <= 0) ? 0 : (std::uint64_t)(rate * 4294967296.0);
+}
+
+}
+
+std::size_t getLocaltime(char *buffer, std::size_t size, std::chrono::system_clock::time_point when)
 {
-    auto now = std::chrono::system_clock::now();
-    std::time_t now_time_t = std::chrono::system_clock::to_time_t(now);
-    std::tm timeinfo;
-    gmtime_r(&now_time_t, &timeinfo);
+    // 'YYYY-MM-DD HH:MM:SS.uuuuuu GMT'
+    if (size < LocaltimeSize) return 0;
 
-    // Time in format '%d-%m-%y %H:%M:%S':
-    std::ostringstream result;
-    result << std::put_time(&timeinfo, "%F %T");
+    struct Cache {
+        std::time_t second = -1;
+        char text[19];
+    };
+    thread_local Cache cache;
+
+    auto unix_usecs = std::chrono::duration_cast<std::chrono::microseconds>(when.time_since_epoch()).count();
+    std::time_t second = unix_usecs / 1000000;
+    long usecs = unix_usecs % 1000000;
+    if (usecs < 0) { // before epoch
+        usecs += 1000000;
+        second--;
+    }
 
-    // Add microseconds:
-    auto unix_usecs = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
-    result << "." << std::setfill('0') << std::setw(6) << (unix_usecs % 1000000);
+    if (second != cache.second) {
+        std::tm timeinfo;
+        gmtime_r(&second, &timeinfo);
+        char *p = cache.text;
+        putDigits(p, timeinfo.tm_year + 1900, 4);
+        p[4] = '-';
+        putDigits(p + 5, timeinfo.tm_mon + 1, 2);
+        p[7] = '-';
+        putDigits(p + 8, timeinfo.tm_mday, 2);
+        p[10] = ' ';
+        putDigits(p + 11, timeinfo.tm_hour, 2);
+        p[13] = ':';
+        putDigits(p + 14, timeinfo.tm_min, 2);
+        p[16] = ':';
+        putDigits(p + 17, timeinfo.tm_sec, 2);
+        cache.second = second;
+    }
 
-    // Add timezone:
-    result << std::put_time(&timeinfo, " %Z");
+    std::memcpy(buffer, cache.text, sizeof(cache.text));
+    buffer[19] = '.';
+    putDigits(buffer + 20, usecs, 6);
+    std::memcpy(buffer + 26, " GMT", 5);
 
-    return result.str();
+    return LocaltimeSize - 1;
+}
+
+std::string getLocaltime()
+{
+    char result[LocaltimeSize];
+    return std::string(result, getLocaltime(result, sizeof(result)));
 }
 
 std::mutex Logger::mutex_;
-Logger::Level Logger::level_ = Logger::Warning;
-bool Logger::initialized_ = false;
-bool Logger::verbose_ = false;
+Logger::State Logger::state_ { { Logger::Warning | Logger::GenerationUnit } };
+std::map<std::string, Logger::Level> Logger::categories_;
+thread_local int Logger::granted_ = -1;
+std::atomic<std::uint64_t> Logger::sampling_[8] = {
+    { 1ULL << 32 }, { 1ULL << 32 }, { 1ULL << 32 }, { 1ULL << 32 }, { 1ULL << 32 }, { 1ULL << 32 }, { 1ULL << 32 }, { 1ULL << 32 }
+};
+thread_local std::uint64_t Logger::random_state_ = 0;
+RateLimiter Logger::rate_limiter_;
+Logger::SuppressedFlusher Logger::suppressed_flusher_;
+std::atomic<bool> Logger::initialized_(false);
+std::atomic<int> Logger::format_(Logger::Text);
+std::atomic<bool> Logger::dump_on_terminate_(false);
+
+std::atomic<RecordQueue*> Logger::queue_(nullptr);
+std::unique_ptr<RecordQueue> Logger::queue_storage_;
+std::thread Logger::drainer_;
+std::atomic<bool> Logger::draining_(false);
+std::atomic<bool> Logger::drainer_sleeping_(false);
+std::atomic<int> Logger::producers_(0);
+std::atomic<std::uint64_t> Logger::async_drops_(0);
+AsyncOptions::Overflow Logger::overflow_ = AsyncOptions::DropNewest;
+std::chrono::milliseconds Logger::overflow_timeout_(100);
+int Logger::overflow_level_ = LOG_ERR;
+std::atomic<std::uint64_t> Logger::overflow_drops_[8] = {};
+std::mutex Logger::drainer_mutex_;
+std::condition_variable Logger::drainer_cv_;
+std::chrono::milliseconds Logger::drainer_idle_wait_(10);
+
+thread_local bool Logger::drainer_thread_ = false;
+
+Logger::SinkReaders Logger::sink_readers_;
+thread_local int Logger::SinkReaders::depth = 0;
+std::vector<std::shared_ptr<const void>> Logger::sinks_retired_;
+std::atomic<const Logger::SinkSet*> Logger::sink_set_(nullptr);
+
+void Logger::verbose(const ConsoleSinkOptions &options)
+{
+    console().configure(options);
+    verbose(true);
+}
+
+ConsoleSink &Logger::console()
+{
+    static ConsoleSink result;
+    return result;
+}
+
+void Logger::setLevel(const std::string &category, const Level level)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    categories_[category] = (level <= Error) ? Error : level;
+    state_.word.fetch_add(GenerationUnit, std::memory_order_acq_rel);
+}
+
+void Logger::unsetLevel(const std::string &category)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    categories_.erase(category);
+    state_.word.fetch_add(GenerationUnit, std::memory_order_acq_rel);
+}
+
+Logger::Level Logger::getLevel(const std::string &category)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto it = categories_.find(category);
+    return (it != categories_.end()) ? it->second : getLevel();
+}
+
+std::uint64_t Logger::refresh(Category &category)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    std::uint64_t state = state_.word.load(std::memory_order_acquire);
+    auto it = categories_.find(category.name_);
+    std::uint64_t level = (it != categories_.end()) ? it->second : (state & LevelMask);
+    std::uint64_t result = ((state >> GenerationShift) << 8) | level;
+    category.cache_.store(result, std::memory_order_relaxed);
+    return result;
+}
+
+void Logger::setSampling(const Level level, double rate)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    sampling_[level & 7].store(samplingThreshold(rate), std::memory_order_relaxed);
+
+    bool sampling = false;
+    for (const auto &value : sampling_) sampling |= (value.load(std::memory_order_relaxed) <= 0xffffffff);
+    if (sampling) state_.word.fetch_or(SamplingFlag, std::memory_order_acq_rel);
+    else state_.word.fetch_and(~SamplingFlag, std::memory_order_acq_rel);
+}
+
+void Logger::configure(const Configuration &configuration)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+
+    for (const auto &category : configuration.categories) {
+        if (category.second == -1) categories_.erase(category.first);
+        else categories_[category.first] = (category.second <= Error) ? Error : (Level)category.second;
+    }
+
+    bool sampling = false;
+    for (int level = 0; level < 8; level++) {
+        if (configuration.sampling[level] >= 0) sampling_[level].store(samplingThreshold(configuration.sampling[level]), std::memory_order_relaxed);
+        sampling |= (sampling_[level].load(std::memory_order_relaxed) <= 0xffffffff);
+    }
+
+    // Single state transition (level, verbose, sampling and generation for categories):
+    std::uint64_t current = state_.word.load(std::memory_order_relaxed);
+    std::uint64_t next;
+    do {
+        next = current & ~SamplingFlag;
+        if (configuration.level != -1) next = (next & ~LevelMask) | (std::uint64_t)((configuration.level <= Error) ? Error : configuration.level);
+        if (configuration.verbose != -1) next = configuration.verbose ? (next | VerboseFlag) : (next & ~VerboseFlag);
+        if (sampling) next |= SamplingFlag;
+        next += GenerationUnit;
+    } while (!state_.word.compare_exchange_weak(current, next, std::memory_order_acq_rel));
+
+    setlogmask(LOG_UPTO(next & LevelMask));
+}
+
+bool Logger::watchConfiguration(const std::string &path, bool hangup)
+{
+    return ConfigWatcher::start(path, hangup);
+}
+
+void Logger::unwatchConfiguration()
+{
+    ConfigWatcher::stop();
+}
+
+std::uint64_t Logger::seed()
+{
+    // splitmix64 over time and thread-specific address, never zero
+    std::uint64_t z = (std::uint64_t)std::chrono::steady_clock::now().time_since_epoch().count() ^ (std::uint64_t)(std::uintptr_t)&random_state_;
+    z += 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    z ^= z >> 31;
+    return z ? z : 1;
+}
+
+void Logger::setRateLimit(const RateLimitOptions &options)
+{
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        rate_limiter_.configure(options);
+        state_.word.fetch_or(RateLimitFlag, std::memory_order_acq_rel);
+    }
+    suppressed_flusher_.start(options.flushInterval);
+}
+
+void Logger::unsetRateLimit()
+{
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        state_.word.fetch_and(~RateLimitFlag, std::memory_order_acq_rel);
+    }
+    suppressed_flusher_.stop();
+    reportSuppressed();
+}
+
+void Logger::SuppressedFlusher::start(std::chrono::milliseconds period)
+{
+    std::lock_guard<std::mutex> guard(control);
+    join();
+    if (period.count() <= 0) return;
+
+    interval = period;
+    thread = std::thread([this] {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!cv.wait_for(lock, interval, [this] { return interval.count() == 0; })) {
+            lock.unlock();
+            rate_limiter_.collect([](int level, const char *file, int line, const char *function, std::uint64_t suppressed) {
+                reportSuppressed((Level)level, file, line, function, suppressed);
+            }, true);
+            lock.lock();
+        }
+    });
+}
+
+void Logger::SuppressedFlusher::stop()
+{
+    std::lock_guard<std::mutex> guard(control);
+    join();
+}
+
+void Logger::SuppressedFlusher::join()
+{
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        interval = std::chrono::milliseconds(0);
+        cv.notify_one();
+    }
+    if (thread.joinable()) thread.join();
+}
+
+void Logger::reportSuppressed(const Level level, const char* fromFile, const int fromLine, const char* fromFunc, std::uint64_t suppressed)
+{
+    std::string record; // rare: record buffer is in use by the caller
+    const Format style = getFormat();
+    if (style == Text) {
+        appendPrefix(record, level, fromFile, fromLine, fromFunc);
+        format::append(record, "suppressed {} similar messages", suppressed);
+    }
+    else {
+        std::string text;
+        format::append(text, "suppressed {} similar messages", suppressed);
+        appendStructured(record, style, level, fromFile, fromLine, fromFunc, text.data(), text.size());
+        if (style == Json) record.push_back('}');
+    }
+    route(level, record);
+}
+
+void Logger::reportSuppressed()
+{
+    rate_limiter_.collect([](int level, const char *file, int line, const char *function, std::uint64_t suppressed) {
+        reportSuppressed((Level)level, file, line, function, suppressed);
+    });
+}
+
+void Logger::setFlightRecorder(const FlightRecorderOptions &options)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    FlightRecorder::configure(options);
+    dump_on_terminate_.store(options.dumpOnTerminate, std::memory_order_relaxed);
+    std::uint64_t recorded = (std::uint64_t)((options.level < Emergency) ? Emergency : (options.level > Debug) ? Debug : options.level) + 1;
+    std::uint64_t current = state_.word.load(std::memory_order_relaxed);
+    while (!state_.word.compare_exchange_weak(current, (current & ~(RecorderMask << RecorderShift)) | (recorded << RecorderShift), std::memory_order_acq_rel)) {}
+}
+
+bool Logger::SinkReaders::synchronize()
+{
+    if (depth) return false; // a sink changing the configuration: it would wait for itself
+    for (int flip = 0; flip < 2; flip++) {
+        unsigned int previous = phase.fetch_add(1, std::memory_order_seq_cst) & 1;
+        while (count[previous].load(std::memory_order_seq_cst)) std::this_thread::yield();
+    }
+    return true;
+}
+
+void Logger::retire(std::shared_ptr<const void> retired)
+{
+    if (retired) sinks_retired_.push_back(std::move(retired));
+    if (sink_readers_.synchronize()) sinks_retired_.clear();
+}
+
+const Logger::SinkSet &Logger::defaultSinks()
+{
+    // Never destroyed, as records may be written from static destructors. The console
+    // is a static object, so its entry does not own it:
+    static const SinkSet *result = new SinkSet{{
+        SinkEntry{"syslog", std::make_shared<SyslogSink>(), Debug, nullptr},
+        SinkEntry{"console", std::shared_ptr<Sink>(std::shared_ptr<Sink>(), &console()), Debug, nullptr}
+    }};
+    return *result;
+}
+
+const Logger::SinkSet &Logger::sinks()
+{
+    const SinkSet *set = sink_set_.load(std::memory_order_seq_cst);
+    return set ? *set : defaultSinks();
+}
+
+void Logger::setSink(std::shared_ptr<Sink> sink)
+{
+    if (!sink) sink = std::make_shared<SyslogSink>();
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    std::vector<SinkEntry> entries = sinks().entries;
+    std::unique_ptr<SinkEntry> replaced;
+    auto it = entries.begin();
+    while (it != entries.end() && it->name != "syslog") it++;
+    if (it == entries.end()) it = entries.insert(entries.begin(), SinkEntry{"syslog", nullptr, Debug, nullptr});
+    else replaced.reset(new SinkEntry(*it));
+
+    it->sink = std::move(sink);
+    if (it->worker) it->worker = std::make_shared<SinkWorker>(it->sink, it->worker->capacity());
+    publishSinks(std::move(entries));
+    if (!replaced) return;
+    if (replaced->worker) replaced->worker->stop();
+    else replaced->sink->flush();
+}
+
+bool Logger::setBinary(const std::string &path, std::size_t bufferSize)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    state_.word.fetch_and(~BinaryFlag, std::memory_order_acq_rel);
+    if (path.empty()) {
+        BinaryLog::close();
+        return true;
+    }
+
+    if (!BinaryLog::open(path, bufferSize)) return false;
+    state_.word.fetch_or(BinaryFlag, std::memory_order_acq_rel);
+    return true;
+}
+
+void Logger::addSink(const std::string &name, std::shared_ptr<Sink> sink, const SinkOptions &options)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    std::vector<SinkEntry> entries = sinks().entries;
+    auto it = entries.begin();
+    while (it != entries.end() && it->name != name) it++;
+    if (!sink) {
+        if (it == entries.end()) return;
+        sink = it->sink; // reconfiguration
+    }
+
+    std::shared_ptr<SinkWorker> replaced;
+    std::shared_ptr<SinkWorker> worker;
+    if (options.worker) worker = std::make_shared<SinkWorker>(sink, options.queueSize);
+    SinkEntry entry{name, std::move(sink), options.level, std::move(worker)};
+    if (it == entries.end()) entries.push_back(std::move(entry));
+    else {
+        replaced = std::move(it->worker);
+        *it = std::move(entry);
+    }
+    publishSinks(std::move(entries));
+    if (replaced) replaced->stop();
+}
+
+bool Logger::removeSink(const std::string &name)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    std::vector<SinkEntry> entries;
+    std::unique_ptr<SinkEntry> removed; // the current set is released on publication
+    for (const auto &entry : sinks().entries) {
+        if (entry.name == name) removed.reset(new SinkEntry(entry));
+        else entries.push_back(entry);
+    }
+    if (!removed) return false;
+
+    publishSinks(std::move(entries));
+    if (removed->worker) removed->worker->stop();
+    else removed->sink->flush();
+    return true;
+}
+
+void Logger::publishSinks(std::vector<SinkEntry> entries)
+{
+    SinkSet *set = new SinkSet{std::move(entries)};
+    const SinkSet *previous = sink_set_.exchange(set, std::memory_order_seq_cst);
+    retire(std::shared_ptr<const SinkSet>(previous));
+}
+
+void Logger::deliver(const SinkSet &set, const Record &record)
+{
+    std::shared_ptr<const std::string> shared; // created once for all the workers
+    const Sink *verboseOutput = &console();
+    for (const auto &entry : set.entries) {
+        if (record.level > entry.level) continue;
+        if (entry.sink.get() == verboseOutput && !isVerbose()) continue;
+        if (entry.worker) {
+            if (!shared) shared = std::make_shared<const std::string>(record.text, record.size);
+            if (!entry.worker->post(record.level, shared, record.time)) stats::dropped(record.level);
+        }
+        else {
+            entry.sink->write(record);
+            // Asynchronous mode flushes once the queue is drained, and the console has its own flusher:
+            if (!drainer_thread_ && entry.sink.get() != verboseOutput) entry.sink->flush();
+        }
+    }
+}
+
+void Logger::flushSink()
+{
+    SinkReader reader;
+    for (const auto &entry : sinks().entries)
+        if (!entry.worker) entry.sink->flush();
+}
+
+void Logger::initialize(const char *programName, int options, int facility, const AsyncOptions &async)
+{
+    initialize(programName, options, facility);
+    if (queue_.load(std::memory_order_acquire)) return; // already running
+
+    queue_storage_.reset(new RecordQueue(async.capacity, async.recordSize));
+    drainer_idle_wait_ = async.idleWait;
+    overflow_ = async.overflow;
+    overflow_timeout_ = async.blockTimeout;
+    overflow_level_ = async.protectLevel;
+    draining_.store(true, std::memory_order_release);
+    drainer_ = std::thread(drain);
+    queue_.store(queue_storage_.get(), std::memory_order_release);
+}
+
+void Logger::terminate()
+{
+    ConfigWatcher::stop();
+
+    // Producers fall back to synchronous mode from now on. Those which already
+    // loaded the queue finish their push before the final drain, so no record is
+    // left behind and a later initialize() can replace the queue safely:
+    if (queue_.exchange(nullptr, std::memory_order_seq_cst)) {
+        while (producers_.load(std::memory_order_seq_cst)) std::this_thread::yield();
+        draining_.store(false, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> guard(drainer_mutex_);
+            drainer_cv_.notify_one();
+        }
+        if (drainer_.joinable()) drainer_.join();
+        reportOverflow();
+    }
+    suppressed_flusher_.stop();
+    if (state_.word.load(std::memory_order_acquire) & RateLimitFlag) reportSuppressed();
+
+    // Registered sinks are delivered synchronously from now on, after their workers drain:
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        const SinkSet *current = sink_set_.load(std::memory_order_acquire);
+        if (current) {
+            std::vector<SinkEntry> entries = current->entries;
+            std::vector<std::shared_ptr<SinkWorker>> workers;
+            for (auto &entry : entries)
+                if (entry.worker) workers.push_back(std::move(entry.worker));
+            publishSinks(std::move(entries));
+            for (const auto &worker : workers) worker->stop();
+        }
+    }
+
+    flushSink();
+    if (dump_on_terminate_.load(std::memory_order_relaxed) && ((state_.word.load(std::memory_order_acquire) >> RecorderShift) & RecorderMask)) FlightRecorder::dump();
+    state_.word.fetch_and(~BinaryFlag, std::memory_order_acq_rel);
+    BinaryLog::close();
+    if(initialized_.load(std::memory_order_acquire)) closelog();
+}
+
+void Logger::drain()
+{
+    drainer_thread_ = true;
+    RecordQueue *queue = queue_storage_.get();
+    // The slot is released before writing, so a slow sink does not keep the queue full:
+    int level;
+    std::string line;
+    std::uint64_t time;
+    auto consume = [&]() {
+        if (!queue->take(level, line, time)) return false;
+        write((Level)level, line.c_str(), line.size(), time);
+        return true;
+    };
+
+    while (draining_.load(std::memory_order_acquire)) {
+        if (consume()) continue;
+
+        // Batch completed (the queue has room again):
+        reportOverflow();
+        flushSink();
+
+        // Nothing pending: sleep until a producer wakes us up (bounded by the idle wait
+        // in case the notification is lost while we are going to sleep):
+        std::unique_lock<std::mutex> lock(drainer_mutex_);
+        drainer_sleeping_.store(true, std::memory_order_seq_cst);
+        if (queue->size() == 0 && draining_.load(std::memory_order_acquire)) {
+            drainer_cv_.wait_for(lock, drainer_idle_wait_);
+        }
+        drainer_sleeping_.store(false, std::memory_order_relaxed);
+    }
+
+    // Flush what remains:
+    while (consume()) {}
+    flushSink();
+}
+
+bool Logger::overflow(RecordQueue &queue, const Level level, const std::string &record, std::uint64_t time)
+{
+    switch (overflow_) {
+    case AsyncOptions::DropOldest:
+        for (int attempt = 0; attempt < 4; attempt++) { // bounded: other producers compete for the slot
+            queue.pop([](int oldest, const std::string &, std::uint64_t) { discard((Level)oldest); });
+            if (queue.push(level, record.data(), record.size(), time)) return true;
+        }
+        break;
+
+    case AsyncOptions::Block:
+        if (drainer_thread_) break; // the drain thread would wait for itself
+        {
+            auto deadline = std::chrono::steady_clock::now() + overflow_timeout_;
+            do {
+                {
+                    std::lock_guard<std::mutex> guard(drainer_mutex_);
+                    drainer_cv_.notify_one();
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+                if (queue.push(level, record.data(), record.size(), time)) return true;
+            } while (std::chrono::steady_clock::now() < deadline);
+        }
+        break;
+
+    case AsyncOptions::DropBelow:
+        if (level <= overflow_level_) {
+            stats::emitted(level, record.size());
+            write(level, record.c_str(), record.size(), time);
+            return false;
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    discard(level);
+    return false;
+}
+
+void Logger::discard(const Level level)
+{
+    async_drops_.fetch_add(1, std::memory_order_relaxed);
+    overflow_drops_[level & 7].fetch_add(1, std::memory_order_relaxed);
+    stats::dropped(level);
+}
+
+void Logger::reportOverflow()
+{
+    std::uint64_t total = 0;
+    std::string detail;
+    for (int level = 0; level < 8; level++) {
+        if (!overflow_drops_[level].load(std::memory_order_relaxed)) continue;
+        std::uint64_t drops = overflow_drops_[level].exchange(0, std::memory_order_relaxed);
+        if (!drops) continue;
+        format::append(detail, "{}{}: {}", total ? ", " : "", levelAsString((Level)level), drops);
+        total += drops;
+    }
+    if (!total) return;
+
+    std::string record;
+    std::string text;
+    format::append(text, "asynchronous queue overflow: dropped {} records ({})", total, detail);
+    const Format style = getFormat();
+    if (style == Text) {
+        appendPrefix(record, Warning, nullptr, 0, nullptr);
+        record.append(text);
+    }
+    else {
+        appendStructured(record, style, Warning, nullptr, 0, nullptr, text.data(), text.size());
+        if (style == Json) record.push_back('}');
+    }
+    route(Warning, record);
+}
+
+void Logger::write(const Level level, const char* line, std::size_t size, std::uint64_t time)
+{
+    SinkReader reader;
+    deliver(sinks(), Record{level, line, size, time});
+}
 
 std::string Logger::asString(const char* format, ...)
 {
     va_list ap;
     char aux [8192];
     va_start(ap, format);
-    vsnprintf(aux, sizeof(aux), format, ap);
+    int size = vsnprintf(aux, sizeof(aux), format, ap);
     va_end(ap);
-    return std::string(aux);
+
+    if (size < (int)sizeof(aux)) return std::string(aux, (size > 0) ? size:0);
+
+    // Longer texts are formatted again on heap instead of being truncated:
+    std::string result(size, '\0');
+    va_start(ap, format);
+    vsnprintf(&result[0], size + 1, format, ap);
+    va_end(ap);
+    return result;
 }
 
 bool Logger::setLevel(const std::string &level) {
@@ -94,17 +689,131 @@ bool Logger::setLevel(const std::string &level) {
     return true;
 }
 
-void Logger::log(const Level level, const char* text, const char* fromFile, const int fromLine, const char* fromFunc)
+std::string &Logger::buffer()
+{
+    thread_local std::string result;
+    return result;
+}
+
+std::string &Logger::scratch()
+{
+    thread_local std::string result;
+    return result;
+}
+
+void Logger::appendStructured(std::string &record, const Format style, const Level level, const char* fromFile, const int fromLine, const char* fromFunc, const char *message, std::size_t size)
 {
-    if(isActive(level)) {
-        const char *s_level = levelAsString(level);
-        syslog(level, "[%s]|%s:%d(%s)|%s", (s_level ? s_level:"<level not supported>"), fromFile, fromLine, fromFunc, text);
+    const char *s_level = levelAsString(level);
+    if (!s_level) s_level = "<level not supported>";
+    char s_line[16];
+    auto res = std::to_chars(s_line, s_line + sizeof(s_line), fromLine);
+    const bool json = (style == Json);
+
+    record.append(json ? "{\"level\":\"" : "level=").append(s_level);
+    if (json) record.push_back('"');
+    if (fromFile) {
+        record.append(json ? ",\"file\":" : " file=");
+        structured::appendString(record, json, fromFile, std::strlen(fromFile));
+        record.append(json ? ",\"line\":" : " line=").append(s_line, res.ptr - s_line);
+        record.append(json ? ",\"function\":" : " function=");
+        structured::appendString(record, json, fromFunc, std::strlen(fromFunc));
+    }
+    record.append(json ? ",\"msg\":\"" : " msg=\"");
+    structured::appendEscaped(record, message, size);
+    record.push_back('"');
+}
+
+void Logger::appendPrefix(std::string &record, const Level level, const char* fromFile, const int fromLine, const char* fromFunc)
+{
+    const char *s_level = levelAsString(level);
+    char s_line[16];
+    auto res = std::to_chars(s_line, s_line + sizeof(s_line), fromLine);
+
+    record.append("[").append(s_level ? s_level:"<level not supported>").append("]|");
+    if (!fromFile) return;
+    record.append(fromFile).append(":").append(s_line, res.ptr - s_line);
+    record.append("(").append(fromFunc).append(")|");
+}
 
-        if(verbose_) {
-            std::string trace = asString("%s: [%s]|%s:%d(%s)|%s", getLocaltime().c_str(), (s_level ? s_level:"<level not supported>"), fromFile, fromLine, fromFunc, text);
-            (level <= Error ? std::cerr:std::cout) << trace << '\n';
+void Logger::dispatch(const Level level, const std::string &record, const char* fromFile, const int fromLine, const char* fromFunc)
+{
+    if (ERT_UNLIKELY(state_.word.load(std::memory_order_relaxed) & RateLimitFlag)) {
+        std::uint64_t suppressed;
+        if (!rate_limiter_.admit(level, fromFile, fromLine, fromFunc, record.data(), record.size(), suppressed)) {
+            stats::suppressed(level);
+            return;
         }
+        if (suppressed) reportSuppressed(level, fromFile, fromLine, fromFunc, suppressed);
+    }
+
+    route(level, record);
+}
+
+void Logger::route(const Level level, const std::string &record)
+{
+    // Announced before loading the queue, so terminate() waits for this push:
+    producers_.fetch_add(1, std::memory_order_seq_cst);
+    RecordQueue *queue = queue_.load(std::memory_order_seq_cst);
+    if (!queue) {
+        producers_.fetch_sub(1, std::memory_order_release);
+        stats::emitted(level, record.size());
+        write(level, record.c_str(), record.size(), Clock::now());
+        return;
+    }
+
+    const std::uint64_t time = Clock::now();
+    const bool queued = ERT_LIKELY(queue->push(level, record.data(), record.size(), time)) || overflow(*queue, level, record, time);
+    producers_.fetch_sub(1, std::memory_order_release);
+    if (!queued) return;
+
+    stats::emitted(level, record.size());
+    if (drainer_sleeping_.load(std::memory_order_seq_cst)) {
+        std::lock_guard<std::mutex> guard(drainer_mutex_);
+        drainer_cv_.notify_one();
+    }
+}
+
+void Logger::log(const Level level, const char* text, const char* fromFile, const int fromLine, const char* fromFunc)
+{
+    if(!isAllowed(level)) return;
+    LatencyScope latency;
+    if (ERT_UNLIKELY(isRecorded(level))) FlightRecorder::record(level, fromFile, fromLine, fromFunc, text, std::strlen(text));
+    if (!isOutput(level)) return;
+
+    std::string &record = buffer();
+    record.clear();
+    const Format style = getFormat();
+    if (ERT_LIKELY(style == Text)) {
+        appendPrefix(record, level, fromFile, fromLine, fromFunc);
+        record.append(text);
+    }
+    else {
+        appendStructured(record, style, level, fromFile, fromLine, fromFunc, text, std::strlen(text));
+        if (style == Json) record.push_back('}');
+    }
+    dispatch(level, record, fromFile, fromLine, fromFunc);
+}
+
+void Logger::log(const CallSite &site, const char* text)
+{
+    const Level level = (Level)site.level;
+    if(!isAllowed(level)) return;
+    LatencyScope latency;
+    if (ERT_UNLIKELY(isRecorded(level))) FlightRecorder::record(level, site.file, site.line, site.function, text, std::strlen(text));
+    if (!isOutput(level)) return;
+
+    std::string &record = buffer();
+    const Format style = getFormat();
+    if (ERT_LIKELY(style == Text)) {
+        record.assign(site.prefix, site.prefixSize);
+        record.append(text);
+    }
+    else {
+        record.clear();
+        appendStructured(record, style, level, site.file, site.line, site.function, text, std::strlen(text));
+        if (style == Json) record.push_back('}');
     }
+    dispatch(level, record, site.file, site.line, site.function);
 }
 
 const char* Logger::levelAsString(const Level level)
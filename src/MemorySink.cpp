@@ -0,0 +1,78 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <ert/tracing/MemorySink.hpp>
+
+
+namespace ert {
+namespace tracing {
+
+void MemorySink::write(const Record &record)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (records_.size() == capacity_) records_.pop_front();
+    records_.emplace_back(record.level, std::string(record.text, record.size));
+    count_++;
+}
+
+std::vector<std::pair<int, std::string>> MemorySink::records() const
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    return std::vector<std::pair<int, std::string>>(records_.begin(), records_.end());
+}
+
+bool MemorySink::contains(const std::string &text) const
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    for (const auto &record : records_)
+        if (record.second.find(text) != std::string::npos) return true;
+    return false;
+}
+
+std::uint64_t MemorySink::count() const
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    return count_;
+}
+
+void MemorySink::clear()
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    records_.clear();
+    count_ = 0;
+}
+
+}
+}
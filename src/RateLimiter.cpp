@@ -0,0 +1,151 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <ert/tracing/RateLimiter.hpp>
+
+
+namespace ert {
+namespace tracing {
+
+namespace {
+
+std::uint64_t hash(const char *data, std::size_t size)
+{
+    // FNV-1a
+    std::uint64_t result = 14695981039346656037ULL;
+    for (std::size_t k = 0; k < size; k++) {
+        result ^= (unsigned char)data[k];
+        result *= 1099511628211ULL;
+    }
+    return result;
+}
+
+}
+
+std::int64_t RateLimiter::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool RateLimiter::isExpired(const Slot &slot, std::int64_t time) const
+{
+    const std::int64_t window = duplicate_window_.load(std::memory_order_relaxed);
+    if (window && time - slot.last_time.load(std::memory_order_relaxed) < window) return false;
+
+    const std::int64_t interval = interval_.load(std::memory_order_relaxed);
+    return (!interval || time >= slot.tat.load(std::memory_order_relaxed) - tolerance_.load(std::memory_order_relaxed));
+}
+
+void RateLimiter::configure(const RateLimitOptions &options)
+{
+    std::int64_t interval = (options.rate > 0) ? (std::int64_t)(1e9 / options.rate) : 0;
+    interval_.store(interval, std::memory_order_relaxed);
+    tolerance_.store(interval * (options.burst > 1 ? options.burst - 1 : 0), std::memory_order_relaxed);
+    duplicate_window_.store(options.suppressDuplicates ? std::chrono::duration_cast<std::chrono::nanoseconds>(options.duplicateWindow).count() : 0, std::memory_order_relaxed);
+}
+
+RateLimiter::Slot *RateLimiter::find(int level, const char *file, int line, const char *function)
+{
+    std::uint64_t key = ((std::uint64_t)(std::uintptr_t)file * 31 + (std::uint64_t)line) * 0x9e3779b97f4a7c15ULL;
+    if (!key) key = 1;
+
+    // Linear probing, limited: sites not fitting are not limited
+    for (std::size_t probe = 0; probe < 8; probe++) {
+        Slot &slot = slots_[(key + probe) % Slots];
+        std::uint64_t current = slot.key.load(std::memory_order_acquire);
+        if (current == key) return &slot;
+        if (current == 0) {
+            if (slot.key.compare_exchange_strong(current, key, std::memory_order_acq_rel)) {
+                slot.level.store(level, std::memory_order_relaxed);
+                slot.line.store(line, std::memory_order_relaxed);
+                slot.file.store(file, std::memory_order_relaxed);
+                slot.function.store(function, std::memory_order_release);
+                return &slot;
+            }
+            if (current == key) return &slot;
+        }
+    }
+
+    return nullptr;
+}
+
+bool RateLimiter::admit(int level, const char *file, int line, const char *function, const char *text, std::size_t size, std::uint64_t &suppressed)
+{
+    suppressed = 0;
+    Slot *slot = find(level, file, line, function);
+    if (!slot) return true;
+
+    const std::int64_t time = now();
+
+    // Duplicates:
+    const std::int64_t window = duplicate_window_.load(std::memory_order_relaxed);
+    std::uint64_t text_hash = 0;
+    if (window) {
+        text_hash = hash(text, size);
+        if (slot->last_hash.load(std::memory_order_relaxed) == text_hash && time - slot->last_time.load(std::memory_order_relaxed) < window) {
+            slot->suppressed.fetch_add(1, std::memory_order_relaxed);
+            total_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+
+    // Token bucket (GCRA):
+    const std::int64_t interval = interval_.load(std::memory_order_relaxed);
+    if (interval) {
+        const std::int64_t tolerance = tolerance_.load(std::memory_order_relaxed);
+        std::int64_t tat = slot->tat.load(std::memory_order_relaxed);
+        for (;;) {
+            if (time < tat - tolerance) {
+                slot->suppressed.fetch_add(1, std::memory_order_relaxed);
+                total_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            std::int64_t next = ((tat > time) ? tat : time) + interval;
+            if (slot->tat.compare_exchange_weak(tat, next, std::memory_order_relaxed)) break;
+        }
+    }
+
+    if (window) {
+        slot->last_hash.store(text_hash, std::memory_order_relaxed);
+        slot->last_time.store(time, std::memory_order_relaxed);
+    }
+
+    if (slot->suppressed.load(std::memory_order_relaxed)) suppressed = slot->suppressed.exchange(0, std::memory_order_acq_rel);
+    return true;
+}
+
+}
+}
+
@@ -0,0 +1,338 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#include <ert/tracing/Clock.hpp>
+#include <ert/tracing/SharedRing.hpp>
+
+
+namespace ert {
+namespace tracing {
+
+namespace {
+
+constexpr std::uint64_t Magic = 0x676e6972747265ULL; // "ertring"
+constexpr std::uint32_t Version = 3;
+
+std::uint32_t checksum(std::uint64_t position, int level, const char *text, std::size_t size)
+{
+    // FNV-1a over text, seeded with the slot position and level:
+    std::uint32_t hash = 2166136261u ^ (std::uint32_t)position ^ ((std::uint32_t)level << 24);
+    for (std::size_t k = 0; k < size; k++) hash = (hash ^ (unsigned char)text[k]) * 16777619u;
+    return hash;
+}
+
+// getpid() is a system call: cached, and refreshed in forked children
+std::atomic<pid_t> process_id(0);
+
+pid_t processId()
+{
+    pid_t pid = process_id.load(std::memory_order_relaxed);
+    if (pid) return pid;
+
+    static std::once_flag registered;
+    std::call_once(registered, [] { pthread_atfork(nullptr, nullptr, [] { process_id.store(0, std::memory_order_relaxed); }); });
+    pid = getpid();
+    process_id.store(pid, std::memory_order_relaxed);
+    return pid;
+}
+
+std::size_t roundUpPowerOfTwo(std::size_t value)
+{
+    std::size_t result = 1;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+}
+
+struct SharedRing::Header {
+    std::atomic<std::uint64_t> magic; // set once the ring is initialized
+    std::uint32_t version;
+    std::uint32_t slotSize;
+    std::uint64_t slots;
+    alignas(64) std::atomic<std::uint64_t> tail; // next position reserved by writers
+    alignas(64) std::atomic<std::uint64_t> head; // next position delivered by the collector
+    std::atomic<std::uint64_t> discarded;
+    alignas(64) std::atomic<std::uint64_t> drops;
+};
+
+struct SharedRing::Slot {
+    std::atomic<std::uint64_t> sequence; // position: free, position + 1: published
+    std::uint64_t position;
+    std::uint64_t time; // nanoseconds since epoch (0: not stamped)
+    std::int32_t level;
+    std::uint32_t size;
+    std::uint32_t checksum;
+    std::int32_t pid; // writer process id
+
+    char *text() {
+        return reinterpret_cast<char*>(this + 1);
+    }
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "shared memory atomics must be lock-free");
+
+SharedRing::SharedRing(const SharedRingOptions &options) : options_(options), header_(nullptr), slots_(nullptr), mapped_(0), mask_(0), slot_size_(0), stalled_position_(~(std::uint64_t)0)
+{
+    static_assert(sizeof(Slot) == 40, "unexpected slot header size");
+
+    std::size_t slots = roundUpPowerOfTwo(std::max(options.slots, (std::size_t)2));
+    std::size_t slotSize = (std::max(options.slotSize, (std::size_t)128) + 63) & ~(std::size_t)63;
+    std::size_t size = sizeof(Header) + slots * slotSize;
+
+    bool creator = true;
+    int fd = shm_open(options.name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0660);
+    if (fd == -1 && errno == EEXIST) {
+        creator = false;
+        fd = shm_open(options.name.c_str(), O_RDWR | O_CLOEXEC, 0);
+    }
+    if (fd == -1) return;
+
+    if (creator) {
+        if (ftruncate(fd, size) != 0) {
+            close(fd);
+            shm_unlink(options.name.c_str());
+            return;
+        }
+    }
+    else {
+        // Wait for the creator to size and initialize the ring, then adopt its layout:
+        struct stat st;
+        for (int attempt = 0; attempt < 1000 && fstat(fd, &st) == 0 && (std::size_t)st.st_size < sizeof(Header); attempt++) usleep(1000);
+        if (fstat(fd, &st) != 0 || (std::size_t)st.st_size < sizeof(Header)) {
+            close(fd);
+            return;
+        }
+        size = st.st_size;
+    }
+
+    void *address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) return;
+    Header *header = static_cast<Header*>(address);
+
+    if (creator) {
+        new (header) Header();
+        header->version = Version;
+        header->slotSize = slotSize;
+        header->slots = slots;
+        char *base = static_cast<char*>(address) + sizeof(Header);
+        for (std::size_t k = 0; k < slots; k++) new (base + k * slotSize) Slot{ { k }, 0, 0, 0, 0, 0, 0 };
+        header->magic.store(Magic, std::memory_order_release);
+    }
+    else {
+        for (int attempt = 0; attempt < 1000 && header->magic.load(std::memory_order_acquire) != Magic; attempt++) usleep(1000);
+        if (header->magic.load(std::memory_order_acquire) != Magic || header->version != Version ||
+            (header->slots & (header->slots - 1)) || header->slotSize < 128 || sizeof(Header) + header->slots * header->slotSize != size) {
+            munmap(address, size);
+            return;
+        }
+        slots = header->slots;
+        slotSize = header->slotSize;
+    }
+
+    slots_ = static_cast<char*>(address) + sizeof(Header);
+    mapped_ = size;
+    mask_ = slots - 1;
+    slot_size_ = slotSize;
+    header_ = header;
+}
+
+SharedRing::~SharedRing()
+{
+    if (header_) munmap(header_, mapped_);
+}
+
+SharedRing::Slot *SharedRing::slot(std::uint64_t position) const
+{
+    return reinterpret_cast<Slot*>(slots_ + (position & mask_) * slot_size_);
+}
+
+bool SharedRing::push(int level, const char *text, std::size_t size, std::uint64_t time)
+{
+    if (!header_) return false;
+
+    // TSC stamps need the writer calibration, which the collector process does not have:
+    if (time) time = Clock::toNanoseconds(time);
+
+    Slot *target;
+    std::uint64_t position = header_->tail.load(std::memory_order_relaxed);
+    for (;;) {
+        target = slot(position);
+        std::uint64_t sequence = target->sequence.load(std::memory_order_acquire);
+        std::int64_t diff = (std::int64_t)(sequence - position);
+        if (diff == 0) {
+            if (header_->tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+        }
+        else if (diff < 0) {
+            header_->drops.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        else {
+            position = header_->tail.load(std::memory_order_relaxed);
+        }
+    }
+
+    size = std::min(size, slot_size_ - sizeof(Slot));
+    target->position = position;
+    target->time = time;
+    target->level = level;
+    target->size = size;
+    target->pid = processId();
+    std::memcpy(target->text(), text, size);
+    target->checksum = checksum(position, level, text, size);
+
+    // Fails only if the collector abandoned the slot because this writer stalled:
+    std::uint64_t expected = position;
+    return target->sequence.compare_exchange_strong(expected, position + 1, std::memory_order_release, std::memory_order_relaxed);
+}
+
+std::size_t SharedRing::drain(const std::function<void(const Record&)> &consumer, std::size_t max)
+{
+    if (!header_) return 0;
+
+    thread_local std::string text; // copy validated before delivery
+    std::size_t count = 0;
+    std::uint64_t position = header_->head.load(std::memory_order_relaxed);
+
+    while (count < max) {
+        Slot *target = slot(position);
+        std::uint64_t sequence = target->sequence.load(std::memory_order_acquire);
+
+        if (sequence == position + 1) {
+            int level = target->level;
+            std::uint64_t time = target->time;
+            int pid = target->pid;
+            std::size_t size = std::min((std::size_t)target->size, slot_size_ - sizeof(Slot));
+            text.assign(target->text(), size);
+            if (target->position == position && target->checksum == checksum(position, level, text.data(), size)) {
+                consumer(Record{level, text.data(), size, time, pid});
+                count++;
+            }
+            else {
+                header_->discarded.fetch_add(1, std::memory_order_relaxed);
+            }
+            target->sequence.store(position + mask_ + 1, std::memory_order_release);
+        }
+        else if (sequence == position && header_->tail.load(std::memory_order_acquire) > position) {
+            // Reserved but not published yet: the writer may have died
+            auto now = std::chrono::steady_clock::now();
+            if (stalled_position_ != position) {
+                stalled_position_ = position;
+                stalled_since_ = now;
+                break;
+            }
+            if (now - stalled_since_ < options_.stallTimeout) break;
+            std::uint64_t expected = position;
+            if (!target->sequence.compare_exchange_strong(expected, position + mask_ + 1, std::memory_order_acq_rel)) continue; // just published
+            header_->drops.fetch_add(1, std::memory_order_relaxed); // record lost, as if the ring was full
+        }
+        else {
+            break; // empty
+        }
+
+        header_->head.store(++position, std::memory_order_release);
+    }
+
+    return count;
+}
+
+std::uint64_t SharedRing::drops() const
+{
+    return header_ ? header_->drops.load(std::memory_order_relaxed) : 0;
+}
+
+std::uint64_t SharedRing::discarded() const
+{
+    return header_ ? header_->discarded.load(std::memory_order_relaxed) : 0;
+}
+
+void SharedRing::unlink(const std::string &name)
+{
+    shm_unlink(name.c_str());
+}
+
+SharedRingCollector::SharedRingCollector(const SharedRingOptions &options, std::shared_ptr<Sink> output, std::size_t batch, std::chrono::milliseconds idleWait) :
+    ring_(options), output_(std::move(output)), batch_(batch ? batch : 1), idle_wait_(idleWait), delivered_(0), stopping_(false)
+{
+    if (ring_.isOpen() && output_) thread_ = std::thread(&SharedRingCollector::run, this);
+}
+
+SharedRingCollector::~SharedRingCollector()
+{
+    stop();
+}
+
+void SharedRingCollector::stop()
+{
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_one();
+    if (thread_.joinable()) thread_.join();
+}
+
+void SharedRingCollector::run()
+{
+    auto consumer = [this](const Record &record) { output_->write(record); };
+
+    for (;;) {
+        std::size_t count = ring_.drain(consumer, batch_);
+        if (count) {
+            output_->flush();
+            delivered_.fetch_add(count, std::memory_order_relaxed);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (stopping_) break;
+        cv_.wait_for(lock, idle_wait_, [this] { return stopping_; });
+    }
+}
+
+}
+}
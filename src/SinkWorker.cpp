@@ -0,0 +1,96 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <ert/tracing/SinkWorker.hpp>
+
+
+namespace ert {
+namespace tracing {
+
+SinkWorker::SinkWorker(std::shared_ptr<Sink> sink, std::size_t capacity) : sink_(std::move(sink)), capacity_(capacity ? capacity : 1), drops_(0), stopping_(false)
+{
+    thread_ = std::thread(&SinkWorker::run, this);
+}
+
+SinkWorker::~SinkWorker()
+{
+    stop();
+}
+
+bool SinkWorker::post(int level, const std::shared_ptr<const std::string> &line, std::uint64_t time)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (stopping_ || pending_.size() >= capacity_) {
+        lock.unlock();
+        drops_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    bool wake = pending_.empty();
+    pending_.push_back(Entry{level, time, line});
+    lock.unlock();
+    if (wake) cv_.notify_one();
+    return true;
+}
+
+void SinkWorker::stop()
+{
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_one();
+    if (thread_.joinable()) thread_.join();
+}
+
+void SinkWorker::run()
+{
+    std::deque<Entry> batch;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+            if (pending_.empty()) break; // stopping and drained
+            batch.swap(pending_);
+        }
+
+        for (const auto &entry : batch) sink_->write(Record{entry.level, entry.line->data(), entry.line->size(), entry.time});
+        sink_->flush();
+        batch.clear();
+    }
+}
+
+}
+}
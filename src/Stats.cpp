@@ -0,0 +1,253 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <atomic>
+#include <charconv>
+#include <mutex>
+#include <vector>
+
+#include <ert/tracing/Logger.hpp>
+#include <ert/tracing/Stats.hpp>
+
+
+namespace ert {
+namespace tracing {
+
+namespace {
+
+// Thread counters: written by the owner thread only (plain load/store, no locked
+// instruction), read by snapshots. Aligned so shards never share a cache line.
+struct alignas(64) Shard {
+    struct Level {
+        std::atomic<std::uint64_t> emitted{0};
+        std::atomic<std::uint64_t> bytes{0};
+        std::atomic<std::uint64_t> drops{0};
+        std::atomic<std::uint64_t> suppressed{0};
+        std::atomic<std::uint64_t> sampled{0};
+    };
+    Level levels[8];
+    std::atomic<std::uint64_t> latency[LatencyHistogram::Buckets] = {};
+    std::atomic<std::uint64_t> latency_count{0};
+    std::atomic<std::uint64_t> latency_sum{0};
+};
+
+inline void add(std::atomic<std::uint64_t> &counter, std::uint64_t value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+void accumulate(Stats &result, const Shard &shard)
+{
+    for (int k = 0; k < 8; k++) {
+        result.levels[k].emitted += shard.levels[k].emitted.load(std::memory_order_relaxed);
+        result.levels[k].bytes += shard.levels[k].bytes.load(std::memory_order_relaxed);
+        result.levels[k].drops += shard.levels[k].drops.load(std::memory_order_relaxed);
+        result.levels[k].suppressed += shard.levels[k].suppressed.load(std::memory_order_relaxed);
+        result.levels[k].sampled += shard.levels[k].sampled.load(std::memory_order_relaxed);
+    }
+    for (std::size_t k = 0; k < LatencyHistogram::Buckets; k++) result.latency.counts[k] += shard.latency[k].load(std::memory_order_relaxed);
+    result.latency.count += shard.latency_count.load(std::memory_order_relaxed);
+    result.latency.sum += shard.latency_sum.load(std::memory_order_relaxed);
+}
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<Shard*> shards;
+    Stats retired; // counters of finished threads
+};
+
+Registry &registry()
+{
+    // Never destroyed: threads may still finish during static destruction
+    static Registry *result = new Registry;
+    return *result;
+}
+
+struct Registration {
+    Shard *shard;
+
+    Registration() : shard(new Shard) {
+        Registry &r = registry();
+        std::lock_guard<std::mutex> guard(r.mutex);
+        r.shards.push_back(shard);
+    }
+
+    ~Registration() {
+        Registry &r = registry();
+        std::lock_guard<std::mutex> guard(r.mutex);
+        accumulate(r.retired, *shard);
+        for (auto it = r.shards.begin(); it != r.shards.end(); it++) {
+            if (*it == shard) {
+                r.shards.erase(it);
+                break;
+            }
+        }
+        delete shard;
+    }
+};
+
+Shard &local()
+{
+    thread_local Registration registration;
+    return *registration.shard;
+}
+
+void appendNumber(std::string &out, std::uint64_t value)
+{
+    char aux[24];
+    auto res = std::to_chars(aux, aux + sizeof(aux), value);
+    out.append(aux, res.ptr - aux);
+}
+
+void appendSeconds(std::string &out, std::uint64_t ns)
+{
+    char aux[32];
+    auto res = std::to_chars(aux, aux + sizeof(aux), ns / 1e9);
+    out.append(aux, res.ptr - aux);
+}
+
+}
+
+std::uint64_t LatencyHistogram::percentile(double quantile) const
+{
+    if (count == 0) return 0;
+    std::uint64_t rank = (std::uint64_t)(quantile * count);
+    if (rank >= count) rank = count - 1;
+
+    std::uint64_t seen = 0;
+    for (std::size_t k = 0; k < Buckets; k++) {
+        seen += counts[k];
+        if (seen > rank) return upperBound(k);
+    }
+    return upperBound(Buckets - 1);
+}
+
+std::string Stats::prometheus(const std::string &prefix) const
+{
+    std::string result;
+
+    struct Counter {
+        const char *name;
+        const char *help;
+        std::uint64_t LevelStats::*field;
+    };
+    static const Counter counters[] = {
+        { "_records_total", "Log records emitted", &LevelStats::emitted },
+        { "_bytes_total", "Text bytes of emitted log records", &LevelStats::bytes },
+        { "_dropped_total", "Log records dropped (asynchronous queue full)", &LevelStats::drops },
+        { "_suppressed_total", "Log records suppressed by rate limiting", &LevelStats::suppressed },
+        { "_sampled_total", "Log statements skipped by sampling", &LevelStats::sampled },
+    };
+
+    for (const Counter &counter : counters) {
+        result.append("# HELP ").append(prefix).append(counter.name).append(" ").append(counter.help).append(" by level.\n");
+        result.append("# TYPE ").append(prefix).append(counter.name).append(" counter\n");
+        for (int level = 0; level < 8; level++) {
+            result.append(prefix).append(counter.name).append("{level=\"").append(Logger::levelAsString((Logger::Level)level)).append("\"} ");
+            appendNumber(result, levels[level].*(counter.field));
+            result.append("\n");
+        }
+    }
+
+    // Histogram buckets at powers of two (64 ns to about 1 s):
+    const std::string name = prefix + "_log_duration_seconds";
+    result.append("# HELP ").append(name).append(" Time spent in log calls.\n");
+    result.append("# TYPE ").append(name).append(" histogram\n");
+    std::uint64_t cumulative = 0;
+    std::size_t bucket = 0;
+    for (int exponent = 6; exponent <= 30; exponent++) {
+        std::uint64_t bound = (std::uint64_t)1 << exponent;
+        while (bucket < LatencyHistogram::Buckets && LatencyHistogram::upperBound(bucket) <= bound) cumulative += latency.counts[bucket++];
+        result.append(name).append("_bucket{le=\"");
+        appendSeconds(result, bound);
+        result.append("\"} ");
+        appendNumber(result, cumulative);
+        result.append("\n");
+    }
+    result.append(name).append("_bucket{le=\"+Inf\"} ");
+    appendNumber(result, latency.count);
+    result.append("\n").append(name).append("_sum ");
+    appendSeconds(result, latency.sum);
+    result.append("\n").append(name).append("_count ");
+    appendNumber(result, latency.count);
+    result.append("\n");
+
+    return result;
+}
+
+namespace stats {
+
+void emitted(int level, std::size_t bytes)
+{
+    Shard::Level &counters = local().levels[level & 7];
+    add(counters.emitted, 1);
+    add(counters.bytes, bytes);
+}
+
+void dropped(int level)
+{
+    add(local().levels[level & 7].drops, 1);
+}
+
+void suppressed(int level)
+{
+    add(local().levels[level & 7].suppressed, 1);
+}
+
+void sampled(int level)
+{
+    add(local().levels[level & 7].sampled, 1);
+}
+
+void latency(std::uint64_t ns)
+{
+    Shard &shard = local();
+    add(shard.latency[LatencyHistogram::bucket(ns)], 1);
+    add(shard.latency_count, 1);
+    add(shard.latency_sum, ns);
+}
+
+Stats snapshot()
+{
+    Registry &r = registry();
+    std::lock_guard<std::mutex> guard(r.mutex);
+    Stats result = r.retired;
+    for (const Shard *shard : r.shards) accumulate(result, *shard);
+    return result;
+}
+
+}
+
+}
+}
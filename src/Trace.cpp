@@ -0,0 +1,268 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+#include <ert/tracing/Trace.hpp>
+
+
+namespace ert {
+namespace tracing {
+
+namespace {
+
+enum Word { Stamp, Name, CategoryName, Start, End, Thread, Words };
+
+std::mutex configuration_mutex;
+
+void appendMicroseconds(std::string &out, std::int64_t ns)
+{
+    // Microseconds with nanosecond decimals, as trace-event timestamps are
+    if (ns < 0) ns = 0;
+    char text[32];
+    auto res = std::to_chars(text, text + sizeof(text), ns / 1000);
+    out.append(text, res.ptr - text);
+    char decimals[4] = { '.', char('0' + ns / 100 % 10), char('0' + ns / 10 % 10), char('0' + ns % 10) };
+    out.append(decimals, 4);
+}
+
+void appendNumber(std::string &out, std::uint64_t value)
+{
+    char text[24];
+    auto res = std::to_chars(text, text + sizeof(text), value);
+    out.append(text, res.ptr - text);
+}
+
+}
+
+struct alignas(64) Trace::Ring {
+    Ring *next = nullptr; // immutable once published
+    std::atomic<bool> busy{false};
+    std::atomic<std::uint64_t> head{0}; // spans written
+    std::atomic<std::uint64_t> thread{0}; // owner thread id
+    std::atomic<std::uint64_t> name[2]; // owner thread name (16 bytes, pthread_getname_np)
+    std::size_t mask;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> slots;
+
+    explicit Ring(std::size_t capacity) : mask(capacity - 1), slots(new std::atomic<std::uint64_t>[capacity * Words]) {
+        for (std::size_t k = 0; k < capacity * Words; k++) slots[k].store(0, std::memory_order_relaxed);
+        name[0].store(0, std::memory_order_relaxed);
+        name[1].store(0, std::memory_order_relaxed);
+    }
+
+    std::atomic<std::uint64_t> *slot(std::uint64_t n) {
+        return &slots[(n & mask) * Words];
+    }
+
+    // Copies span n (sequence stamp excluded): false if overwritten or being written
+    bool read(std::uint64_t n, std::uint64_t *span) {
+        std::atomic<std::uint64_t> *s = slot(n);
+        std::uint64_t stamp = s[Stamp].load(std::memory_order_acquire);
+        if (stamp != 2 * n + 2) return false;
+        for (int k = Name; k < Words; k++) span[k] = s[k].load(std::memory_order_acquire);
+        return (s[Stamp].load(std::memory_order_relaxed) == stamp);
+    }
+};
+
+std::atomic<int> Trace::level_(-1);
+std::atomic<Trace::Ring*> Trace::rings_(nullptr);
+std::atomic<std::size_t> Trace::capacity_(0);
+
+void Trace::enable(const TraceOptions &options)
+{
+    std::lock_guard<std::mutex> guard(configuration_mutex);
+    if (!capacity_.load(std::memory_order_relaxed)) {
+        std::size_t capacity = 1;
+        while (capacity < options.spans) capacity <<= 1;
+        capacity_.store(capacity, std::memory_order_release);
+    }
+    level_.store(options.level, std::memory_order_relaxed);
+}
+
+void Trace::disable()
+{
+    level_.store(-1, std::memory_order_relaxed);
+}
+
+Trace::Ring *Trace::ring()
+{
+    struct Owner {
+        Ring *ring = nullptr;
+        ~Owner() {
+            if (ring) ring->busy.store(false, std::memory_order_release); // spans are kept until reused
+        }
+    };
+    thread_local Owner owner;
+    if (ERT_LIKELY(owner.ring != nullptr)) return owner.ring;
+
+    std::size_t capacity = capacity_.load(std::memory_order_acquire);
+    if (!capacity) return nullptr;
+
+    for (Ring *r = rings_.load(std::memory_order_acquire); r && !owner.ring; r = r->next) {
+        bool expected = false;
+        if (r->busy.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) owner.ring = r;
+    }
+
+    if (!owner.ring) {
+        Ring *r = new Ring(capacity);
+        r->busy.store(true, std::memory_order_relaxed);
+        r->next = rings_.load(std::memory_order_relaxed);
+        while (!rings_.compare_exchange_weak(r->next, r, std::memory_order_acq_rel)) {}
+        owner.ring = r;
+    }
+
+    owner.ring->thread.store((std::uint64_t)::syscall(SYS_gettid), std::memory_order_relaxed);
+    char name[16] = {};
+    pthread_getname_np(pthread_self(), name, sizeof(name));
+    std::uint64_t words[2];
+    std::memcpy(words, name, sizeof(words));
+    owner.ring->name[0].store(words[0], std::memory_order_relaxed);
+    owner.ring->name[1].store(words[1], std::memory_order_relaxed);
+    return owner.ring;
+}
+
+void Trace::record(const char *name, std::uint64_t start, std::uint64_t end, const char *category)
+{
+    Ring *r = ring();
+    if (!r) return;
+
+    std::uint64_t n = r->head.load(std::memory_order_relaxed);
+    std::atomic<std::uint64_t> *s = r->slot(n);
+    // Odd stamp while writing (see FlightRecorder):
+    s[Stamp].store(2 * n + 1, std::memory_order_relaxed);
+    s[Name].store((std::uintptr_t)name, std::memory_order_release);
+    s[CategoryName].store((std::uintptr_t)category, std::memory_order_release);
+    s[Start].store(start, std::memory_order_release);
+    s[End].store(end, std::memory_order_release);
+    s[Thread].store(r->thread.load(std::memory_order_relaxed), std::memory_order_release);
+    s[Stamp].store(2 * n + 2, std::memory_order_release);
+    r->head.store(n + 1, std::memory_order_release);
+}
+
+std::string Trace::json()
+{
+    const std::uint64_t pid = (std::uint64_t)::getpid();
+    const std::uint64_t capacity = capacity_.load(std::memory_order_acquire);
+    std::uint64_t span[Words];
+
+    // Earliest start, as timestamps are relative to it (absolute microseconds lose
+    // precision when parsed as double). Spans are recorded when they end, so the
+    // oldest one of a ring may be nested in a later, earlier starting, one:
+    std::int64_t origin = 0;
+    bool found = false;
+    for (Ring *r = rings_.load(std::memory_order_acquire); r; r = r->next) {
+        std::uint64_t head = r->head.load(std::memory_order_acquire);
+        for (std::uint64_t n = (head > capacity) ? head - capacity : 0; n < head; n++) {
+            if (!r->read(n, span)) continue;
+            std::int64_t start = Clock::toNanoseconds(span[Start]);
+            if (!found || start < origin) origin = start;
+            found = true;
+        }
+    }
+
+    std::string out;
+    out.append("{\"traceEvents\":[");
+    bool first = true;
+    for (Ring *r = rings_.load(std::memory_order_acquire); r; r = r->next) {
+        char name[17] = {};
+        std::uint64_t words[2] = { r->name[0].load(std::memory_order_relaxed), r->name[1].load(std::memory_order_relaxed) };
+        std::memcpy(name, words, 16);
+        std::uint64_t thread = r->thread.load(std::memory_order_relaxed);
+        std::uint64_t head = r->head.load(std::memory_order_acquire);
+
+        for (std::uint64_t n = (head > capacity) ? head - capacity : 0; n < head; n++) {
+            if (!r->read(n, span)) continue; // overwritten meanwhile
+            const char *spanName = (const char *)(std::uintptr_t)span[Name];
+            const char *category = span[CategoryName] ? (const char *)(std::uintptr_t)span[CategoryName] : "ert";
+            std::int64_t start = Clock::toNanoseconds(span[Start]);
+            std::int64_t end = Clock::toNanoseconds(span[End]);
+
+            out.append(first ? "\n" : ",\n");
+            first = false;
+            out.append("{\"name\":\"");
+            structured::appendEscaped(out, spanName, std::strlen(spanName));
+            out.append("\",\"cat\":\"");
+            structured::appendEscaped(out, category, std::strlen(category));
+            out.append("\",\"ph\":\"X\",\"pid\":");
+            appendNumber(out, pid);
+            out.append(",\"tid\":");
+            appendNumber(out, span[Thread]);
+            out.append(",\"ts\":");
+            appendMicroseconds(out, start - origin);
+            out.append(",\"dur\":");
+            appendMicroseconds(out, end - start); // negative if the wall clock was stepped back: 0
+            out.append("}");
+        }
+
+        if (name[0] && thread) { // current (or last) owner
+            out.append(first ? "\n" : ",\n");
+            first = false;
+            out.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":");
+            appendNumber(out, pid);
+            out.append(",\"tid\":");
+            appendNumber(out, thread);
+            out.append(",\"args\":{\"name\":\"");
+            structured::appendEscaped(out, name, std::strlen(name));
+            out.append("\"}}");
+        }
+    }
+
+    char origin_text[LocaltimeSize];
+    std::size_t origin_size = getLocaltime(origin_text, sizeof(origin_text), Clock::toTime(origin));
+    out.append("\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"origin\":\"");
+    out.append(origin_text, origin_size);
+    out.append("\"}}\n");
+    return out;
+}
+
+bool Trace::exportJson(const std::string &path)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+    const std::string document = json();
+    file.write(document.data(), document.size());
+    return (bool)file;
+}
+
+}
+}
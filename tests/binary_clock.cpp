@@ -0,0 +1,143 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Binary log records carry Clock stamps (TSC ticks when the counter is invariant):
+// converted with the calibration stored in the file, they must fall within the
+// interval in which they were logged.
+
+// C
+#include <unistd.h>
+
+// Standard
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Project
+#include <ert/tracing/BinaryLog.hpp>
+#include <ert/tracing/Clock.hpp>
+#include <ert/tracing/Logger.hpp>
+
+#include "Check.hpp"
+
+using ert::tracing::Clock;
+using ert::tracing::Logger;
+
+namespace {
+
+constexpr int Records = 100;
+constexpr std::int64_t Tolerance = 1000000; // nanoseconds (calibration error)
+
+std::int64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+template <typename T>
+T get(const char *&p)
+{
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    p += sizeof(T);
+    return value;
+}
+
+}
+
+int main()
+{
+    const bool tsc = Clock::enable();
+    const std::string path = "/tmp/ert_logger_test_binary_clock." + std::to_string(getpid());
+
+    Logger::setLevel(Logger::Debug);
+    ERT_CHECK(Logger::setBinary(path));
+    const std::int64_t before = nowNs();
+    for (int k = 0; k < Records; k++) ERT_LOG_INFORMATIONAL("record {}", k);
+    const std::int64_t after = nowNs();
+    ERT_CHECK(Logger::setBinary(""));
+    Clock::disable();
+
+    std::ifstream ifs(path, std::ios::binary);
+    std::vector<char> data((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    unlink(path.c_str());
+    ERT_CHECK(data.size() > ert::tracing::binary::MagicSize);
+    ERT_CHECK(std::memcmp(data.data(), ert::tracing::binary::Magic, ert::tracing::binary::MagicSize) == 0);
+
+    Clock::Calibration calibration;
+    bool calibrated = false;
+    int records = 0;
+    std::int64_t previous = before;
+    const char *p = data.data() + ert::tracing::binary::MagicSize;
+    const char *end = data.data() + data.size();
+    while (p < end) {
+        std::uint8_t kind = get<std::uint8_t>(p);
+        std::uint32_t size = get<std::uint32_t>(p);
+        const char *entryEnd = p + size;
+        ERT_CHECK(entryEnd <= end);
+
+        if (kind == ert::tracing::binary::CalibrationEntry) {
+            calibration.baseTicks = get<std::uint64_t>(p);
+            calibration.baseNs = get<std::int64_t>(p);
+            calibration.nsPerTick = get<double>(p);
+            calibrated = true;
+        }
+        else if (kind == ert::tracing::binary::RecordsEntry) {
+            while (p < entryEnd) {
+                get<std::uint32_t>(p); // call site
+                std::uint64_t stamp = get<std::uint64_t>(p);
+                ERT_CHECK(get<std::uint8_t>(p) == 1);
+                ERT_CHECK(get<std::uint8_t>(p) == ert::tracing::binary::Int);
+                ERT_CHECK(get<std::int64_t>(p) == records);
+
+                // Ticks are tagged with the most significant bit, and preceded by a calibration:
+                ERT_CHECK(((stamp >> 63) != 0) == tsc);
+                ERT_CHECK(!tsc || calibrated);
+                std::int64_t ns = Clock::toNanoseconds(stamp, calibration);
+                ERT_CHECK(ns >= before - Tolerance && ns <= after + Tolerance);
+                ERT_CHECK(ns >= previous - Tolerance);
+                previous = ns;
+                records++;
+            }
+        }
+        p = entryEnd;
+    }
+
+    ERT_CHECK(records == Records);
+    return 0;
+}
@@ -0,0 +1,16 @@
+# Checks that a binary built with ERT_LOGGER_COMPILE_MIN_LEVEL=Warning keeps no literal
+# of the statements for less severe levels (and keeps those for Warning).
+#
+# cmake -DBINARY=<path> -P compile_min_level.cmake
+
+file(STRINGS "${BINARY}" compiled_out REGEX "ert-compiled-out-")
+if (compiled_out)
+  message(FATAL_ERROR "Statements under the compile-time level were compiled in: ${compiled_out}")
+endif()
+
+foreach (literal ert-compiled-in-warning-block ert-compiled-in-warning-call-site)
+  file(STRINGS "${BINARY}" compiled_in REGEX "${literal}")
+  if (NOT compiled_in)
+    message(FATAL_ERROR "Warning statement literal '${literal}' not found in the binary")
+  endif()
+endforeach()
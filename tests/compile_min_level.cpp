@@ -0,0 +1,74 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Built with ERT_LOGGER_COMPILE_MIN_LEVEL=Warning: statements for Notice and less severe
+// levels must compile away. compile_min_level.cmake checks that their literals are not
+// in the binary; this program checks that they produce nothing at run time.
+
+// Standard
+#include <memory>
+
+// Project
+#include <ert/tracing/Logger.hpp>
+#include <ert/tracing/MemorySink.hpp>
+
+#include "Check.hpp"
+
+using ert::tracing::Logger;
+
+int main()
+{
+    static_assert(Logger::CompiledLevel == Logger::Warning, "test must be built with ERT_LOGGER_COMPILE_MIN_LEVEL=Warning");
+    static_assert(!Logger::isCompiled(Logger::Debug) && !Logger::isCompiled(Logger::Notice), "levels under Warning are compiled in");
+
+    auto memory = std::make_shared<ert::tracing::MemorySink>();
+    Logger::setSink(memory);
+    Logger::setLevel(Logger::Debug);
+
+    LOGDEBUG(Logger::debug("ert-compiled-out-debug-block", ERT_FILE_LOCATION));
+    LOGNOTICE(Logger::notice("ert-compiled-out-notice-block", ERT_FILE_LOCATION));
+    ERT_LOG_DEBUG("ert-compiled-out-debug-call-site {}", 1);
+    ERT_LOG(Logger::Informational, "ert-compiled-out-informational-call-site");
+
+    LOGWARNING(Logger::warning("ert-compiled-in-warning-block", ERT_FILE_LOCATION));
+    ERT_LOG_WARNING("ert-compiled-in-warning-call-site {}", 1);
+
+    Logger::terminate();
+
+    ERT_CHECK(memory->count() == 2);
+    ERT_CHECK(memory->contains("ert-compiled-in-warning-block"));
+    ERT_CHECK(memory->contains("ert-compiled-in-warning-call-site 1"));
+    return 0;
+}
@@ -0,0 +1,199 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// DatagramSink against a local stand-in for the syslog daemon (an AF_UNIX datagram
+// socket bound by the test): exact RFC 3164 and RFC 5424 frames, batching until
+// flush, and drop/retry counters once the receiver buffer is full.
+
+// C
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <syslog.h>
+#include <time.h>
+#include <unistd.h>
+
+// Standard
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+// Project
+#include <ert/tracing/DatagramSink.hpp>
+
+#include "Check.hpp"
+
+using ert::tracing::DatagramSink;
+using ert::tracing::DatagramSinkOptions;
+using ert::tracing::Record;
+
+namespace {
+
+// 2023-08-02 19:16:46.340729 UTC, as a Clock stamp (nanoseconds since epoch):
+constexpr std::uint64_t Stamp = 1691003806340729000ULL;
+const std::string Text = "[Informational]|datagram_sink.cpp:1(main)|hello";
+
+struct Receiver {
+    std::string path;
+    int fd;
+
+    explicit Receiver(const std::string &directory, int bufferSize = 0) : path(directory + "/log.sock") {
+        fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        ERT_CHECK(fd >= 0);
+        if (bufferSize) setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+        struct sockaddr_un addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+        ERT_CHECK(bind(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0);
+    }
+
+    ~Receiver() {
+        close(fd);
+        unlink(path.c_str());
+    }
+
+    // Next datagram, empty if none is pending:
+    std::string receive() {
+        char buffer[4096];
+        ssize_t size = recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+        return (size > 0) ? std::string(buffer, size) : std::string();
+    }
+};
+
+DatagramSinkOptions options(const Receiver &receiver)
+{
+    DatagramSinkOptions result;
+    result.path = receiver.path;
+    result.ident = "ert-test";
+    result.facility = LOG_LOCAL1;
+    return result;
+}
+
+void frames(const std::string &directory)
+{
+    Receiver receiver(directory);
+    const std::string pid = std::to_string(getpid());
+    const Record record{LOG_INFO, Text.data(), Text.size(), Stamp};
+
+    // <local1.info> = 17 * 8 + 6, local time (the test runs in UTC):
+    DatagramSinkOptions rfc3164 = options(receiver);
+    DatagramSink legacy(rfc3164);
+    legacy.write(record);
+    legacy.flush();
+    ERT_CHECK(receiver.receive() == "<142>Aug  2 19:16:46 ert-test[" + pid + "]: " + Text);
+
+    DatagramSinkOptions rfc5424 = options(receiver);
+    rfc5424.format = DatagramSinkOptions::Rfc5424;
+    char hostname[256] = {};
+    ERT_CHECK(gethostname(hostname, sizeof(hostname) - 1) == 0);
+    DatagramSink modern(rfc5424);
+    modern.write(record);
+    modern.flush();
+    ERT_CHECK(receiver.receive() == "<142>1 2023-08-02T19:16:46.340729Z " + std::string(hostname) + " ert-test " + pid + " - - " + Text);
+
+    // Records of other processes (see SharedRingCollector) carry their writer pid:
+    Record collected = record;
+    collected.pid = 4242;
+    legacy.write(collected);
+    legacy.flush();
+    ERT_CHECK(receiver.receive() == "<142>Aug  2 19:16:46 ert-test[4242]: " + Text);
+    ERT_CHECK(receiver.receive().empty());
+    ERT_CHECK(legacy.sent() == 2 && modern.sent() == 1 && legacy.drops() == 0);
+}
+
+void batch(const std::string &directory)
+{
+    Receiver receiver(directory);
+    DatagramSinkOptions batched = options(receiver);
+    batched.batch = 4;
+    DatagramSink sink(batched);
+    const Record record{LOG_INFO, Text.data(), Text.size(), Stamp};
+
+    // Pending records are kept until the batch is complete, then sent together:
+    for (int k = 0; k < 3; k++) sink.write(record);
+    ERT_CHECK(receiver.receive().empty());
+    ERT_CHECK(sink.sent() == 0);
+    sink.write(record);
+    ERT_CHECK(sink.sent() == 4);
+    for (int k = 0; k < 4; k++) ERT_CHECK(!receiver.receive().empty());
+    ERT_CHECK(receiver.receive().empty());
+
+    // ... or on flush:
+    for (int k = 0; k < 2; k++) sink.write(record);
+    ERT_CHECK(receiver.receive().empty());
+    sink.flush();
+    ERT_CHECK(sink.sent() == 6);
+    for (int k = 0; k < 2; k++) ERT_CHECK(!receiver.receive().empty());
+    ERT_CHECK(receiver.receive().empty());
+}
+
+void full(const std::string &directory)
+{
+    // The receiver never reads, so its buffer fills and the sink gets EAGAIN:
+    Receiver receiver(directory, 4096);
+    DatagramSinkOptions retried = options(receiver);
+    retried.enobufsRetries = 2;
+    retried.enobufsWait = std::chrono::microseconds(10);
+    DatagramSink sink(retried);
+    const Record record{LOG_INFO, Text.data(), Text.size(), Stamp};
+
+    constexpr int Records = 1000;
+    for (int k = 0; k < Records; k++) sink.write(record);
+    sink.flush();
+
+    ERT_CHECK(sink.sent() > 0);
+    ERT_CHECK(sink.drops() > 0);
+    ERT_CHECK(sink.sent() + sink.drops() == Records);
+    ERT_CHECK(sink.retries() == 2 * sink.drops()); // every drop after its retries
+}
+
+}
+
+int main()
+{
+    setenv("TZ", "UTC", 1);
+    tzset();
+
+    char directory[] = "/tmp/ert-datagram-XXXXXX";
+    ERT_CHECK(mkdtemp(directory) != nullptr);
+
+    frames(directory);
+    batch(directory);
+    full(directory);
+
+    rmdir(directory);
+    return 0;
+}
@@ -0,0 +1,120 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Flips the level and verbose output while threads log, synchronous or asynchronous
+// ("async" argument). Meant for the Tsan build type (data races are reported and make
+// the test fail); in any build, records over the highest level set are never lost.
+
+// C
+#include <fcntl.h>
+#include <unistd.h>
+
+// Standard
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Project
+#include <ert/tracing/Logger.hpp>
+#include <ert/tracing/Sink.hpp>
+
+#include "Check.hpp"
+
+using ert::tracing::Logger;
+
+namespace {
+
+constexpr int Threads = 4;
+constexpr int Iterations = 5000;
+
+struct CountingSink : ert::tracing::Sink {
+    std::atomic<std::uint64_t> errors{0};
+    std::atomic<std::uint64_t> others{0};
+    void write(const ert::tracing::Record &record) override {
+        (record.level == Logger::Error ? errors : others).fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+}
+
+int main(int argc, char *argv[])
+{
+    const bool async = (argc > 1 && std::strcmp(argv[1], "async") == 0);
+
+    // Verbose output is not checked:
+    int null = ::open("/dev/null", O_WRONLY);
+    ERT_CHECK(null >= 0 && ::dup2(null, STDOUT_FILENO) == STDOUT_FILENO);
+
+    auto sink = std::make_shared<CountingSink>();
+    if (async) {
+        ert::tracing::AsyncOptions options;
+        options.overflow = ert::tracing::AsyncOptions::Block;
+        Logger::initialize("level_flip_stress", -1, -1, options);
+    }
+    else {
+        Logger::initialize("level_flip_stress");
+    }
+    Logger::setSink(sink);
+    Logger::setLevel(Logger::Debug);
+
+    std::atomic<bool> stop(false);
+    std::thread flipper([&stop] {
+        for (int k = 0; !stop.load(std::memory_order_relaxed); k++) {
+            Logger::setLevel((k & 1) ? Logger::Debug : Logger::Warning);
+            Logger::verbose((k & 2) != 0);
+        }
+    });
+
+    std::vector<std::thread> loggers;
+    for (int t = 0; t < Threads; t++) {
+        loggers.emplace_back([] {
+            for (int i = 0; i < Iterations; i++) {
+                ERT_LOG_DEBUG("debug {}", i);
+                LOGINFORMATIONAL(Logger::informational("informational", ERT_FILE_LOCATION));
+                ERT_LOG_ERROR("error {}", i);
+            }
+        });
+    }
+    for (auto &logger : loggers) logger.join();
+    stop.store(true, std::memory_order_relaxed);
+    flipper.join();
+    Logger::terminate();
+
+    ERT_CHECK(sink->errors.load() == (std::uint64_t)Threads * Iterations);
+    ERT_CHECK(sink->others.load() <= 2 * (std::uint64_t)Threads * Iterations);
+    return 0;
+}
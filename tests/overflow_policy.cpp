@@ -0,0 +1,177 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Asynchronous queue overflow policies against a 16-slot queue and a slow sink. The
+// policy is given as argument (DropNewest, DropOldest, Block or DropBelow); every
+// record carries its sequence number, so the survivors can be checked.
+
+// Standard
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Project
+#include <ert/tracing/Logger.hpp>
+#include <ert/tracing/Sink.hpp>
+
+#include "Check.hpp"
+
+using ert::tracing::AsyncOptions;
+using ert::tracing::Logger;
+
+namespace {
+
+constexpr int Records = 200;
+constexpr std::size_t Capacity = 16;
+
+// Keeps the sequence numbers delivered, by level. When held, writes wait until the
+// producer is done, so the queue surely overflows:
+struct SlowSink : ert::tracing::Sink {
+    std::mutex mutex;
+    std::condition_variable released;
+    bool held = false;
+    std::vector<int> sequences[8];
+    std::vector<std::string> warnings; // overflow reports
+
+    void write(const ert::tracing::Record &record) override {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        std::unique_lock<std::mutex> lock(mutex);
+        released.wait(lock, [this] { return !held; });
+        std::string text(record.text, record.size);
+        std::size_t position = text.find("record ");
+        if (position != std::string::npos) sequences[record.level & 7].push_back(std::stoi(text.substr(position + 7)));
+        else warnings.push_back(text);
+    }
+
+    bool contains(int level, int sequence) {
+        for (int delivered : sequences[level]) if (delivered == sequence) return true;
+        return false;
+    }
+};
+
+bool ascending(const std::vector<int> &sequences)
+{
+    for (std::size_t k = 1; k < sequences.size(); k++) if (sequences[k] <= sequences[k - 1]) return false;
+    return true;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    ERT_CHECK(argc == 2);
+    const std::string policy(argv[1]);
+
+    AsyncOptions options;
+    options.capacity = Capacity;
+    options.blockTimeout = std::chrono::seconds(10);
+    options.protectLevel = LOG_ERR;
+    if (policy == "DropNewest") options.overflow = AsyncOptions::DropNewest;
+    else if (policy == "DropOldest") options.overflow = AsyncOptions::DropOldest;
+    else if (policy == "Block") options.overflow = AsyncOptions::Block;
+    else if (policy == "DropBelow") options.overflow = AsyncOptions::DropBelow;
+    else ERT_CHECK(!"unknown policy");
+
+    // Block and DropBelow (protected records are written by the caller) need the sink moving:
+    auto sink = std::make_shared<SlowSink>();
+    sink->held = (options.overflow == AsyncOptions::DropNewest || options.overflow == AsyncOptions::DropOldest);
+    Logger::setSink(sink);
+    Logger::initialize("overflow_policy", -1, -1, options);
+    Logger::setLevel(Logger::Debug);
+
+    // DropBelow: one in ten records is protected (Error), the rest are Debug:
+    for (int sequence = 0; sequence < Records; sequence++) {
+        if (options.overflow == AsyncOptions::DropBelow && sequence % 10 == 0) ERT_LOG_ERROR("record {}", sequence);
+        else ERT_LOG_DEBUG("record {}", sequence);
+    }
+    {
+        std::lock_guard<std::mutex> guard(sink->mutex);
+        sink->held = false;
+    }
+    sink->released.notify_all();
+    Logger::terminate();
+
+    const std::vector<int> &debug = sink->sequences[Logger::Debug];
+    const std::vector<int> &error = sink->sequences[Logger::Error];
+    const ert::tracing::Stats stats = Logger::stats();
+    const std::uint64_t drops = Logger::asyncDrops();
+    ERT_CHECK(debug.size() + error.size() + drops == Records);
+    ERT_CHECK(stats.levels[Logger::Debug].drops + stats.levels[Logger::Error].drops == drops);
+    ERT_CHECK(ascending(debug)); // protected records written by the caller may pass queued ones
+
+    switch (options.overflow) {
+    case AsyncOptions::DropNewest:
+        // The first records fill the queue, the last ones find it full (the drain thread
+        // may have taken one before the sink stalled):
+        ERT_CHECK(debug.size() <= Capacity + 1);
+        for (int sequence = 0; sequence < (int)Capacity; sequence++) ERT_CHECK(sink->contains(Logger::Debug, sequence));
+        ERT_CHECK(!sink->contains(Logger::Debug, Records - 1));
+        break;
+
+    case AsyncOptions::DropOldest:
+        // The last records evict the queued ones:
+        ERT_CHECK(debug.size() <= Capacity + 1);
+        for (int sequence = Records - (int)Capacity; sequence < Records; sequence++) ERT_CHECK(sink->contains(Logger::Debug, sequence));
+        break;
+
+    case AsyncOptions::Block:
+        ERT_CHECK(drops == 0);
+        ERT_CHECK(debug.size() == Records);
+        ERT_CHECK(sink->warnings.empty());
+        return 0;
+
+    case AsyncOptions::DropBelow:
+        // Protected records all get through, only less severe ones are dropped:
+        ERT_CHECK(drops > 0);
+        ERT_CHECK(error.size() == Records / 10);
+        ERT_CHECK(stats.levels[Logger::Error].drops == 0);
+        break;
+    }
+
+    // Drops are reported once the queue has room again:
+    std::uint64_t reported = 0;
+    for (const std::string &warning : sink->warnings) {
+        std::size_t position = warning.find("asynchronous queue overflow: dropped ");
+        ERT_CHECK(position != std::string::npos);
+        reported += std::stoull(warning.substr(position + 37));
+    }
+    ERT_CHECK(reported == drops);
+    return 0;
+}
@@ -0,0 +1,136 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Replaces the output and registered sinks while threads log: replaced sinks must be
+// released (memory stays bounded however often the configuration changes) and never
+// be written once released.
+
+// Standard
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Project
+#include <ert/tracing/Logger.hpp>
+#include <ert/tracing/Sink.hpp>
+
+#include "Check.hpp"
+
+using ert::tracing::Logger;
+
+namespace {
+
+constexpr int Threads = 3;
+constexpr int Changes = 300;
+
+std::atomic<int> created{0};
+std::atomic<int> destroyed{0};
+
+struct TrackedSink : ert::tracing::Sink {
+    static constexpr std::uint32_t Alive = 0xa11fe;
+    std::atomic<std::uint32_t> magic{Alive};
+    std::atomic<std::uint64_t> records{0};
+
+    TrackedSink() {
+        created.fetch_add(1, std::memory_order_relaxed);
+    }
+    ~TrackedSink() {
+        magic.store(0, std::memory_order_relaxed);
+        destroyed.fetch_add(1, std::memory_order_relaxed);
+    }
+    void write(const ert::tracing::Record &) override {
+        ERT_CHECK(magic.load(std::memory_order_relaxed) == Alive);
+        records.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+}
+
+int main()
+{
+    Logger::initialize("sink_reconfigure");
+    Logger::setSink(std::make_shared<TrackedSink>());
+
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> threads;
+    for (int k = 0; k < Threads; k++) {
+        threads.emplace_back([&stop] {
+            while (!stop.load(std::memory_order_relaxed)) ERT_LOG_ERROR("reconfigured {}", 1);
+        });
+    }
+
+    for (int change = 0; change < Changes; change++) {
+        Logger::setSink(std::make_shared<TrackedSink>());
+        ert::tracing::SinkOptions options;
+        options.worker = (change % 3 == 0);
+        if (change % 2 == 0) Logger::addSink("extra", std::make_shared<TrackedSink>(), options);
+        else Logger::removeSink("extra");
+
+        // The current output and at most one registered sink are alive:
+        ERT_CHECK(created.load() - destroyed.load() <= 2);
+    }
+
+    stop.store(true);
+    for (auto &thread : threads) thread.join();
+
+    Logger::setSink(nullptr);
+    Logger::removeSink("extra");
+    ERT_CHECK(created.load() == destroyed.load());
+
+    // The main output is the "syslog" entry: its options survive setSink(), and it is
+    // reconfigured or removed like any registered sink:
+    Logger::setLevel(Logger::Debug);
+    ert::tracing::SinkOptions errorsOnly;
+    errorsOnly.level = Logger::Error;
+    Logger::addSink("syslog", nullptr, errorsOnly);
+    auto output = std::make_shared<TrackedSink>();
+    Logger::setSink(output);
+    ERT_LOG_WARNING("filtered {}", 1);
+    ERT_LOG_ERROR("delivered {}", 1);
+    ERT_CHECK(output->records.load() == 1);
+
+    ERT_CHECK(Logger::removeSink("syslog"));
+    ERT_LOG_ERROR("not delivered {}", 1);
+    ERT_CHECK(output->records.load() == 1);
+    Logger::setSink(output); // registered again, with default options
+    ERT_LOG_WARNING("delivered {}", 2);
+    ERT_CHECK(output->records.load() == 2);
+
+    Logger::setSink(nullptr);
+    output.reset();
+    ERT_CHECK(created.load() == destroyed.load());
+    return 0;
+}
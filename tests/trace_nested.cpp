@@ -0,0 +1,117 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Nested spans are recorded innermost first (when they end): the exported timestamps
+// must be relative to the earliest start, so every parent contains its children.
+
+// Standard
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+// Project
+#include <ert/tracing/Trace.hpp>
+
+#include "Check.hpp"
+
+using ert::tracing::Trace;
+
+namespace {
+
+constexpr double Lead = 2000; // microseconds elapsed in a span before its child starts
+constexpr double Epsilon = 0.001; // one nanosecond, the exported precision
+
+struct Event {
+    double ts;
+    double dur;
+};
+
+void pause()
+{
+    std::this_thread::sleep_for(std::chrono::microseconds((int)Lead));
+}
+
+double number(const std::string &json, std::size_t from, const char *key)
+{
+    std::size_t pos = json.find(key, from);
+    ERT_CHECK(pos != std::string::npos);
+    return std::strtod(json.c_str() + pos + std::char_traits<char>::length(key), nullptr);
+}
+
+Event event(const std::string &json, const char *name)
+{
+    std::size_t pos = json.find(std::string("{\"name\":\"") + name + "\"");
+    ERT_CHECK(pos != std::string::npos);
+    return Event{number(json, pos, "\"ts\":"), number(json, pos, "\"dur\":")};
+}
+
+void contains(const Event &parent, const Event &child)
+{
+    ERT_CHECK(parent.ts <= child.ts + Epsilon);
+    ERT_CHECK(parent.ts + parent.dur + Epsilon >= child.ts + child.dur);
+    ERT_CHECK(child.ts - parent.ts + Epsilon >= Lead);
+}
+
+}
+
+int main()
+{
+    Trace::enable();
+    {
+        ERT_TRACE_SPAN("outer");
+        pause();
+        {
+            ERT_TRACE_SPAN("middle");
+            pause();
+            {
+                ERT_TRACE_SPAN("inner");
+                pause();
+            }
+            pause();
+        }
+        pause();
+    }
+    const std::string json = Trace::json();
+    Trace::disable();
+
+    const Event outer = event(json, "outer");
+    const Event middle = event(json, "middle");
+    const Event inner = event(json, "inner");
+    ERT_CHECK(outer.ts < Epsilon); // the earliest start is the origin
+    contains(outer, middle);
+    contains(middle, inner);
+    return 0;
+}
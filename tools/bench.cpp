@@ -0,0 +1,463 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// C
+#include <fcntl.h>
+#include <libgen.h> // basename
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Standard
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ert/tracing/DatagramSink.hpp>
+#include <ert/tracing/Logger.hpp>
+#include <ert/tracing/Trace.hpp>
+
+// Microbenchmarks: ns/op and allocations/op of the logger hot paths, with no
+// syslog daemon involved (records go to a stub sink or to a local stand-in socket).
+
+using ert::tracing::Logger;
+
+const char* progname;
+
+////////////////////////////////
+// Allocation counting        //
+////////////////////////////////
+static thread_local std::uint64_t Allocations = 0;
+
+void* operator new(std::size_t size) {
+    Allocations++;
+    if (void *p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+// Replacement deallocation releasing with free() what the replacement new got
+// from malloc(): GCC may flag it as mismatched once both are inlined
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+// Prevents the compiler from optimizing out benchmarked results
+template <typename T>
+inline void keep(const T &value) {
+    asm volatile("" : : "m"(value) : "memory");
+}
+
+////////////////////////////////
+// Sinks                      //
+////////////////////////////////
+class StubSink : public ert::tracing::Sink {
+public:
+    void write(const ert::tracing::Record &record) override {
+        keep(record.text[record.size - 1]);
+    }
+};
+
+// Local AF_UNIX datagram socket standing in for the syslog daemon
+class StandIn {
+    std::string path_;
+    int fd_;
+    std::atomic<bool> stopping_;
+    std::thread reader_;
+
+public:
+    StandIn() : fd_(-1), stopping_(false) {
+        path_ = "/tmp/ert_logger_bench." + std::to_string(getpid()) + ".sock";
+        ::unlink(path_.c_str());
+        fd_ = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        struct sockaddr_un address {};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path_.c_str(), sizeof(address.sun_path) - 1);
+        if (fd_ < 0 || ::bind(fd_, (struct sockaddr*)&address, sizeof(address)) != 0) {
+            std::perror("stand-in socket");
+            std::exit(EXIT_FAILURE);
+        }
+        struct timeval timeout { 0, 100000 };
+        ::setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        reader_ = std::thread([this] {
+            char datagram[2048];
+            while (!stopping_.load(std::memory_order_relaxed)) ::recv(fd_, datagram, sizeof(datagram), 0);
+        });
+    }
+
+    ~StandIn() {
+        stopping_ = true;
+        reader_.join();
+        ::close(fd_);
+        ::unlink(path_.c_str());
+    }
+
+    const std::string &path() const {
+        return path_;
+    }
+};
+
+////////////////////////////////
+// Measurement                //
+////////////////////////////////
+struct Result {
+    std::string name;
+    unsigned threads;
+    std::uint64_t iterations; // per thread
+    double nsPerOp; // wall time per operation on every thread
+    double allocsPerOp;
+    double opsPerSecond; // all threads
+};
+
+typedef std::function<void(std::uint64_t)> Body; // runs the operation a number of times
+
+struct Options {
+    std::chrono::milliseconds minTime{200};
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::string filter;
+    enum Format { Table, Json, Csv } format = Table;
+};
+
+class Bench {
+    const Options &options_;
+    std::vector<Result> results_;
+
+    bool selected(const std::string &name) const {
+        return options_.filter.empty() || name.find(options_.filter) != std::string::npos;
+    }
+
+    // Runs body on 'threads' threads at once, 'iterations' times each
+    Result measure(const std::string &name, unsigned threads, std::uint64_t iterations, const Body &body) {
+        std::atomic<unsigned> ready(0);
+        std::atomic<bool> go(false);
+        std::atomic<std::uint64_t> allocations(0);
+        std::vector<std::thread> workers;
+
+        auto work = [&] {
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            std::uint64_t before = Allocations;
+            body(iterations);
+            allocations.fetch_add(Allocations - before);
+        };
+
+        for (unsigned i = 1; i < threads; i++) workers.emplace_back(work);
+        while (ready.load() != threads - 1) std::this_thread::yield();
+
+        auto start = std::chrono::steady_clock::now();
+        ready.fetch_add(1);
+        go.store(true, std::memory_order_release);
+        work();
+        for (auto &worker : workers) worker.join();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        double ops = (double)iterations * threads;
+        return Result{ name, threads, iterations, ns / iterations, allocations.load() / ops, ops * 1e9 / ns };
+    }
+
+    // Doubles the iterations until a single thread run lasts the minimum time
+    std::uint64_t calibrate(const Body &body) {
+        double minimum = std::chrono::duration<double, std::nano>(options_.minTime).count();
+        std::uint64_t iterations = 1;
+        body(1); // warm-up (thread-local buffers, cached timestamps ...)
+        while (true) {
+            auto start = std::chrono::steady_clock::now();
+            body(iterations);
+            double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            if (ns >= minimum || iterations >= ((std::uint64_t)1 << 40)) return iterations;
+            iterations = (ns > minimum / 64) ? (std::uint64_t)(iterations * minimum * 1.1 / ns) + 1 : iterations * 64;
+        }
+    }
+
+public:
+    explicit Bench(const Options &options) : options_(options) {}
+
+    void run(const std::string &name, const Body &body) {
+        if (!selected(name)) return;
+        results_.push_back(measure(name, 1, calibrate(body), body));
+    }
+
+    // Contention curve: 1, 2, 4 ... up to the configured number of threads
+    void curve(const std::string &name, const Body &body) {
+        if (!selected(name)) return;
+        std::uint64_t iterations = calibrate(body);
+        for (unsigned threads = 1; ; threads = std::min(threads * 2, options_.threads)) {
+            results_.push_back(measure(name, threads, iterations, body));
+            if (threads == options_.threads) break;
+        }
+    }
+
+    void report(FILE *out) const {
+        switch (options_.format) {
+        case Options::Json:
+            std::fprintf(out, "[\n");
+            for (std::size_t i = 0; i < results_.size(); i++) {
+                const Result &r = results_[i];
+                std::fprintf(out, "  {\"name\": \"%s\", \"threads\": %u, \"iterations\": %llu, \"ns_per_op\": %.2f, \"allocs_per_op\": %.3f, \"ops_per_sec\": %.0f}%s\n",
+                             r.name.c_str(), r.threads, (unsigned long long)r.iterations, r.nsPerOp, r.allocsPerOp, r.opsPerSecond,
+                             (i + 1 < results_.size()) ? "," : "");
+            }
+            std::fprintf(out, "]\n");
+            break;
+        case Options::Csv:
+            std::fprintf(out, "name,threads,iterations,ns_per_op,allocs_per_op,ops_per_sec\n");
+            for (const Result &r : results_)
+                std::fprintf(out, "%s,%u,%llu,%.2f,%.3f,%.0f\n", r.name.c_str(), r.threads, (unsigned long long)r.iterations,
+                             r.nsPerOp, r.allocsPerOp, r.opsPerSecond);
+            break;
+        default:
+            std::fprintf(out, "%-24s %7s %12s %12s %13s %14s\n", "benchmark", "threads", "iterations", "ns/op", "allocs/op", "ops/s");
+            for (const Result &r : results_)
+                std::fprintf(out, "%-24s %7u %12llu %12.2f %13.3f %14.0f\n", r.name.c_str(), r.threads, (unsigned long long)r.iterations,
+                             r.nsPerOp, r.allocsPerOp, r.opsPerSecond);
+        }
+        std::fflush(out);
+    }
+};
+
+// Redirects standard output and error to /dev/null while in scope (verbose benchmarks)
+class Silence {
+    int out_, err_;
+
+public:
+    Silence() : out_(::dup(STDOUT_FILENO)), err_(::dup(STDERR_FILENO)) {
+        int null = ::open("/dev/null", O_WRONLY | O_CLOEXEC);
+        ::dup2(null, STDOUT_FILENO);
+        ::dup2(null, STDERR_FILENO);
+        ::close(null);
+    }
+
+    ~Silence() {
+        ::dup2(out_, STDOUT_FILENO);
+        ::dup2(err_, STDERR_FILENO);
+        ::close(out_);
+        ::close(err_);
+    }
+};
+
+////////////////////////////////
+// Benchmarks                 //
+////////////////////////////////
+void benchmarks(Bench &bench) {
+    auto stub = std::make_shared<StubSink>();
+    Logger::setSink(stub);
+
+    // Filtered out traces:
+    Logger::setLevel(Logger::Error);
+    bench.run("isActive.disabled", [](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; i++) {
+            bool active = Logger::isActive(Logger::Debug);
+            keep(active);
+        }
+    });
+    bench.run("LOGDEBUG.disabled", [](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; i++) LOGDEBUG(Logger::debug("never", ERT_FILE_LOCATION));
+    });
+    bench.run("ERT_LOG_DEBUG.disabled", [](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; i++) ERT_LOG_DEBUG("never {}", i);
+    });
+    Logger::setLevel(Logger::Debug);
+
+    // Helpers:
+    bench.run("asString", [](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; i++) {
+            std::string s = Logger::asString("value=%llu name=%s", (unsigned long long)i, "bench");
+            keep(s);
+        }
+    });
+    bench.run("getLocaltime", [](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; i++) {
+            std::string s = ert::tracing::getLocaltime();
+            keep(s);
+        }
+    });
+    bench.run("getLocaltime.buffer", [](std::uint64_t n) {
+        char buffer[ert::tracing::LocaltimeSize];
+        for (std::uint64_t i = 0; i < n; i++) {
+            std::size_t size = ert::tracing::getLocaltime(buffer, sizeof(buffer));
+            keep(buffer[size - 1]);
+        }
+    });
+    bench.run("clock.system_clock", [](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; i++) keep(std::chrono::system_clock::now());
+    });
+    if (ert::tracing::Clock::enable()) {
+        bench.run("clock.tsc", [](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; i++) keep(ert::tracing::Clock::now());
+        });
+    }
+    ert::tracing::Clock::disable();
+
+    // Logging into the stub sink:
+    Body log = [](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; i++) Logger::log(Logger::Debug, "benchmark trace text", ERT_FILE_LOCATION);
+    };
+    Body logf = [](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; i++) Logger::logf(Logger::Debug, ERT_FILE_LOCATION, "value={} name={}", i, "bench");
+    };
+    Body site = [](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; i++) ERT_LOG_DEBUG("value={} name={}", i, "bench");
+    };
+    bench.curve("log.stub", log);
+    bench.curve("logf.stub", logf);
+    bench.curve("ERT_LOG_DEBUG.stub", site);
+
+    Logger::setSampling(Logger::Debug, 0.01);
+    bench.run("ERT_LOG_DEBUG.sampled", site);
+    Logger::setSampling(Logger::Debug, 1);
+
+    Body structured = [](std::uint64_t n) {
+        using ert::tracing::kv;
+        for (std::uint64_t i = 0; i < n; i++) Logger::log(Logger::Debug, ERT_FILE_LOCATION, "request served", kv("user", i), kv("ms", 1.5), kv("path", "/api/v1/items"));
+    };
+    bench.run("log.kv.text", structured);
+    Logger::setFormat(Logger::Json);
+    bench.run("log.kv.json", structured);
+    Logger::setFormat(Logger::Logfmt);
+    bench.run("log.kv.logfmt", structured);
+    Logger::setFormat(Logger::Text);
+
+    Logger::measureLatency(true);
+    bench.run("log.stub.latency", log);
+    Logger::measureLatency(false);
+
+    // Scoped spans (disabled, then recorded; Debug level is active here):
+    Body span = [](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; i++) {
+            ERT_TRACE_SPAN("bench");
+        }
+    };
+    bench.run("ERT_TRACE_SPAN.disabled", span);
+    ert::tracing::Trace::enable();
+    bench.curve("ERT_TRACE_SPAN", span);
+    ert::tracing::Clock::enable();
+    bench.run("ERT_TRACE_SPAN.tsc", span);
+    ert::tracing::Clock::disable();
+    ert::tracing::Trace::disable();
+
+    // Records stamped when logged:
+    ert::tracing::Clock::enable();
+    bench.run("log.stub.stamped", log);
+    ert::tracing::Clock::disable();
+
+    // Verbose (console output discarded):
+    {
+        Silence silence;
+        Logger::verbose(true);
+        bench.curve("log.verbose", log);
+        Logger::verbose(false);
+    }
+
+    // Native syslog sink against the stand-in socket:
+    {
+        StandIn standIn;
+        ert::tracing::DatagramSinkOptions options;
+        options.path = standIn.path();
+        options.ident = "ert_logger_bench";
+        auto datagram = std::make_shared<ert::tracing::DatagramSink>(options);
+        Logger::setSink(datagram);
+        bench.curve("log.datagram", log);
+        Logger::setSink(stub);
+    }
+}
+
+////////////////////////////////
+// Command line functionality //
+////////////////////////////////
+void usage(int rc)
+{
+    auto& ss = (rc == 0) ? std::cout : std::cerr;
+
+    ss << "Usage: " << progname << " [options]\n\n"
+       << "Options:\n\n"
+       << "--threads <n>\n  Maximum threads for contention curves (hardware concurrency by default).\n\n"
+       << "--min-time <milliseconds>\n  Minimum single thread time per benchmark (200 by default).\n\n"
+       << "--filter <text>\n  Only benchmarks whose name contains the text.\n\n"
+       << "--json\n  JSON array output.\n\n"
+       << "--csv\n  CSV output.\n\n"
+       << "[--help|-h]\n  This help.\n\n";
+
+    exit(rc);
+}
+
+int main(int argc, char* argv[]) {
+
+    progname = basename(argv[0]);
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+
+        if (arg == "--help" || arg == "-h") usage(EXIT_SUCCESS);
+        else if (arg == "--json") options.format = Options::Json;
+        else if (arg == "--csv") options.format = Options::Csv;
+        else if (arg == "--threads" && hasValue) options.threads = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--min-time" && hasValue) options.minTime = std::chrono::milliseconds(std::max(1, std::atoi(argv[++i])));
+        else if (arg == "--filter" && hasValue) options.filter = argv[++i];
+        else usage(EXIT_FAILURE);
+    }
+
+    Logger::initialize(progname);
+
+    Bench bench(options);
+    benchmarks(bench);
+    bench.report(stdout);
+
+    Logger::terminate();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,148 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// C
+#include <libgen.h> // basename
+#include <signal.h>
+#include <syslog.h>
+
+// Standard
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <ert/tracing/DatagramSink.hpp>
+#include <ert/tracing/FileSink.hpp>
+#include <ert/tracing/SharedRing.hpp>
+
+// Drains the shared memory ring written by worker processes (SharedRingSink)
+// into syslog (batched datagrams, see DatagramSink) or a rotating file, until
+// SIGINT or SIGTERM. Records keep the process id of the worker which wrote them.
+
+const char* progname;
+
+void usage(int rc)
+{
+    auto& ss = (rc == 0) ? std::cout : std::cerr;
+
+    ss << "Usage: " << progname << " [options]\n\n"
+       << "Options:\n\n"
+       << "--name <name>\n  Shared memory object name ('/ert-logger' by default).\n\n"
+       << "--slots <n>\n  Ring records, when created by the collector (16384 by default).\n\n"
+       << "--slot-size <bytes>\n  Ring record size, when created by the collector (512 by default).\n\n"
+       << "--ident <name>\n  Syslog program name (collector name by default).\n\n"
+       << "--socket <path>\n  Syslog daemon datagram socket ('/dev/log' by default).\n\n"
+       << "--file <path>\n  Writes a rotating file (see FileSink) instead of syslog.\n\n"
+       << "--batch <n>\n  Maximum records per batch (1024 by default).\n\n"
+       << "--unlink\n  Removes the shared memory object on exit.\n\n"
+       << "[--help|-h]\n  This help.\n\n";
+
+    exit(rc);
+}
+
+int main(int argc, char* argv[]) {
+
+    progname = basename(argv[0]);
+    ert::tracing::SharedRingOptions options;
+    std::string ident = progname;
+    std::string socket = "/dev/log";
+    std::string file;
+    std::size_t batch = 1024;
+    bool unlink = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+
+        if (arg == "--help" || arg == "-h") usage(EXIT_SUCCESS);
+        else if (arg == "--unlink") unlink = true;
+        else if (arg == "--name" && hasValue) options.name = argv[++i];
+        else if (arg == "--slots" && hasValue) options.slots = std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--slot-size" && hasValue) options.slotSize = std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--ident" && hasValue) ident = argv[++i];
+        else if (arg == "--socket" && hasValue) socket = argv[++i];
+        else if (arg == "--file" && hasValue) file = argv[++i];
+        else if (arg == "--batch" && hasValue) batch = std::strtoul(argv[++i], nullptr, 10);
+        else usage(EXIT_FAILURE);
+    }
+
+    // Signals are accepted synchronously (blocked before the collector thread starts):
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    std::shared_ptr<ert::tracing::Sink> output;
+    std::shared_ptr<ert::tracing::DatagramSink> datagramSink;
+    if (file.empty()) {
+        ert::tracing::DatagramSinkOptions datagramOptions;
+        datagramOptions.path = socket;
+        datagramOptions.ident = ident;
+        datagramOptions.facility = LOG_LOCAL1;
+        datagramOptions.batch = batch;
+        datagramSink = std::make_shared<ert::tracing::DatagramSink>(datagramOptions);
+        output = datagramSink;
+    }
+    else {
+        ert::tracing::FileSinkOptions fileOptions;
+        fileOptions.path = file;
+        auto fileSink = std::make_shared<ert::tracing::FileSink>(fileOptions);
+        if (!fileSink->isOpen()) {
+            std::cerr << "Cannot create '" << file << "'" << '\n';
+            exit(EXIT_FAILURE);
+        }
+        output = fileSink;
+    }
+
+    ert::tracing::SharedRingCollector collector(options, output, batch);
+    if (!collector.ring().isOpen()) {
+        std::cerr << "Cannot open shared memory ring '" << options.name << "'" << '\n';
+        exit(EXIT_FAILURE);
+    }
+
+    int signal;
+    sigwait(&signals, &signal);
+    collector.stop();
+    if (unlink) ert::tracing::SharedRing::unlink(options.name);
+
+    std::cerr << progname << ": " << collector.delivered() << " records delivered, " << collector.ring().drops() << " dropped (ring full or writer stalled), "
+              << collector.ring().discarded() << " discarded (torn)";
+    if (datagramSink) std::cerr << ", " << datagramSink->drops() << " not sent to syslog";
+    std::cerr << '\n';
+
+    return 0;
+}
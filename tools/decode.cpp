@@ -0,0 +1,270 @@
+/*
+ _________________________________________________________
+|             _          _                               |
+|            | |        | |                              |
+|    ___ _ __| |_   __  | | ___   __ _  __ _  ___ _ __   |
+|   / _ \ '__| __| |__| | |/ _ \ / _` |/ _` |/ _ \ '__|  |  Syslog wrapper library C++
+|  |  __/ |  | |_       | | (_) | (_| | (_| |  __/ |     |  Version 1.0.z
+|   \___|_|   \__|      |_|\___/ \__, |\__, |\___|_|     |  https://github.com/testillano/logger
+|                                 __/ | __/ |            |
+|                                |___/ |___/             |
+|________________________________________________________|
+
+Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+SPDX-License-Identifier: MIT
+Copyright (c) 2021 Eduardo Ramos
+
+Permission is hereby  granted, free of charge, to any  person obtaining a copy
+of this software and associated  documentation files (the "Software"), to deal
+in the Software  without restriction, including without  limitation the rights
+to  use, copy,  modify, merge,  publish, distribute,  sublicense, and/or  sell
+copies  of  the Software,  and  to  permit persons  to  whom  the Software  is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE  IS PROVIDED "AS  IS", WITHOUT WARRANTY  OF ANY KIND,  EXPRESS OR
+IMPLIED,  INCLUDING BUT  NOT  LIMITED TO  THE  WARRANTIES OF  MERCHANTABILITY,
+FITNESS FOR  A PARTICULAR PURPOSE AND  NONINFRINGEMENT. IN NO EVENT  SHALL THE
+AUTHORS  OR COPYRIGHT  HOLDERS  BE  LIABLE FOR  ANY  CLAIM,  DAMAGES OR  OTHER
+LIABILITY, WHETHER IN AN ACTION OF  CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE  OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// C
+#include <libgen.h> // basename
+
+// Standard
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <ert/tracing/BinaryLog.hpp>
+#include <ert/tracing/Clock.hpp>
+#include <ert/tracing/Logger.hpp>
+
+// Renders binary log files (see ert::tracing::BinaryLog) as text lines
+
+const char* progname;
+
+struct Site {
+    int level;
+    std::uint32_t line;
+    std::string file;
+    std::string function;
+    std::string format;
+};
+
+class Reader {
+    const char *p_;
+    const char *end_;
+
+public:
+    Reader(const char *data, std::size_t size) : p_(data), end_(data + size) {}
+
+    bool empty() const {
+        return p_ >= end_;
+    }
+
+    template <typename T>
+    bool get(T &value) {
+        if (end_ - p_ < (std::ptrdiff_t)sizeof(T)) return false;
+        std::memcpy(&value, p_, sizeof(T));
+        p_ += sizeof(T);
+        return true;
+    }
+
+    bool getBytes(std::string &value, std::size_t size) {
+        if (end_ - p_ < (std::ptrdiff_t)size) return false;
+        value.assign(p_, size);
+        p_ += size;
+        return true;
+    }
+
+    bool getString(std::string &value) {
+        std::uint32_t size;
+        return (get(size) && getBytes(value, size));
+    }
+};
+
+bool decodeArgument(Reader &reader, std::string &out)
+{
+    std::uint8_t tag;
+    if (!reader.get(tag)) return false;
+
+    switch (tag) {
+    case ert::tracing::binary::Bool: {
+        char value;
+        if (!reader.get(value)) return false;
+        ert::tracing::format::appendArgument(out, (bool)value);
+        return true;
+    }
+    case ert::tracing::binary::Char: {
+        char value;
+        if (!reader.get(value)) return false;
+        ert::tracing::format::appendArgument(out, value);
+        return true;
+    }
+    case ert::tracing::binary::Int: {
+        std::int64_t value;
+        if (!reader.get(value)) return false;
+        ert::tracing::format::appendArgument(out, value);
+        return true;
+    }
+    case ert::tracing::binary::UInt: {
+        std::uint64_t value;
+        if (!reader.get(value)) return false;
+        ert::tracing::format::appendArgument(out, value);
+        return true;
+    }
+    case ert::tracing::binary::Double: {
+        double value;
+        if (!reader.get(value)) return false;
+        ert::tracing::format::appendArgument(out, value);
+        return true;
+    }
+    case ert::tracing::binary::String: {
+        std::string value;
+        if (!reader.getString(value)) return false;
+        out.append(value);
+        return true;
+    }
+    case ert::tracing::binary::Pointer: {
+        std::uint64_t value;
+        if (!reader.get(value)) return false;
+        ert::tracing::format::appendArgument(out, (const void*)(std::uintptr_t)value);
+        return true;
+    }
+    }
+
+    return false;
+}
+
+bool decodeRecords(Reader &reader, const std::map<std::uint32_t, Site> &sites, const ert::tracing::Clock::Calibration &calibration, bool timestamps)
+{
+    std::vector<std::string> args;
+    std::string line;
+
+    while (!reader.empty()) {
+        std::uint32_t id;
+        std::uint64_t stamp;
+        std::uint8_t argc;
+        if (!reader.get(id) || !reader.get(stamp) || !reader.get(argc)) return false;
+
+        args.resize(argc);
+        for (auto &arg : args) {
+            arg.clear();
+            if (!decodeArgument(reader, arg)) return false;
+        }
+
+        auto it = sites.find(id);
+        if (it == sites.end()) {
+            std::cerr << "Unknown call site identifier " << id << '\n';
+            return false;
+        }
+        const Site &site = it->second;
+
+        line.clear();
+        if (timestamps) {
+            char timestamp[ert::tracing::LocaltimeSize];
+            std::int64_t ns = ert::tracing::Clock::toNanoseconds(stamp, calibration);
+            std::chrono::system_clock::time_point when(std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(ns)));
+            line.append(timestamp, ert::tracing::getLocaltime(timestamp, sizeof(timestamp), when)).append(": ");
+        }
+
+        const char *s_level = ert::tracing::Logger::levelAsString((ert::tracing::Logger::Level)site.level);
+        line.append("[").append(s_level ? s_level:"<level not supported>").append("]|");
+        line.append(site.file).append(":").append(std::to_string(site.line));
+        line.append("(").append(site.function).append(")|");
+
+        const char *format = site.format.c_str();
+        for (const auto &arg : args) {
+            format = ert::tracing::format::appendLiteral(line, format);
+            if (!format) break;
+            line.append(arg);
+        }
+        if (format) ert::tracing::format::append(line, format);
+
+        std::cout << line << '\n';
+    }
+
+    return true;
+}
+
+void usage(int rc)
+{
+    auto& ss = (rc == 0) ? std::cout : std::cerr;
+
+    ss << '\n' << "Usage: " << progname << " <binary log file> [--timestamps (to prefix records with their time)]" << '\n';
+
+    exit(rc);
+}
+
+int main(int argc, char* argv[]) {
+    progname = basename(argv[0]);
+
+    if (argc < 2) usage(EXIT_FAILURE);
+    bool timestamps = (argc > 2 && std::string(argv[2]) == "--timestamps");
+
+    std::ifstream ifs(argv[1], std::ios::binary);
+    if (!ifs) {
+        std::cerr << "Cannot open '" << argv[1] << "'" << '\n';
+        exit(EXIT_FAILURE);
+    }
+    std::vector<char> data((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+
+    if (data.size() < ert::tracing::binary::MagicSize || std::memcmp(data.data(), ert::tracing::binary::Magic, ert::tracing::binary::MagicSize) != 0) {
+        std::cerr << "Not a binary log file: '" << argv[1] << "'" << '\n';
+        exit(EXIT_FAILURE);
+    }
+
+    Reader reader(data.data() + ert::tracing::binary::MagicSize, data.size() - ert::tracing::binary::MagicSize);
+    std::map<std::uint32_t, Site> sites;
+    ert::tracing::Clock::Calibration calibration; // TSC stamps: the last one written before them
+
+    while (!reader.empty()) {
+        std::uint8_t kind;
+        std::uint32_t size;
+        if (!reader.get(kind) || !reader.get(size)) break;
+
+        std::string body;
+        if (!reader.getBytes(body, size)) {
+            std::cerr << "Truncated file" << '\n';
+            exit(EXIT_FAILURE);
+        }
+        Reader entry(body.data(), body.size());
+
+        if (kind == ert::tracing::binary::SiteEntry) {
+            std::uint32_t id;
+            std::uint8_t level;
+            Site site;
+            if (!entry.get(id) || !entry.get(level) || !entry.get(site.line) || !entry.getString(site.file) || !entry.getString(site.function) || !entry.getString(site.format)) {
+                std::cerr << "Corrupted call site entry" << '\n';
+                exit(EXIT_FAILURE);
+            }
+            site.level = level;
+            sites[id] = site;
+        }
+        else if (kind == ert::tracing::binary::CalibrationEntry) {
+            if (!entry.get(calibration.baseTicks) || !entry.get(calibration.baseNs) || !entry.get(calibration.nsPerTick)) {
+                std::cerr << "Corrupted calibration entry" << '\n';
+                exit(EXIT_FAILURE);
+            }
+        }
+        else if (kind == ert::tracing::binary::RecordsEntry) {
+            if (!decodeRecords(entry, sites, calibration, timestamps)) {
+                std::cerr << "Corrupted records entry" << '\n';
+                exit(EXIT_FAILURE);
+            }
+        }
+    }
+
+    exit(EXIT_SUCCESS);
+}